@@ -58,5 +58,21 @@ printbuffer(const char_t* format,
             const uint8_t* buffer,
             int32_t len);
 
+/* ̨ж(printf.c) */
+extern uint16_t
+console_isr_getchar(uint8_t *pch);
+
+extern uint32_t
+console_isr_lost(void);
+
+extern void
+console_panic(bool_e enable);
+
+/* ض(printf.c), tidΪTASK_ID */
+typedef void (*console_out_t)(void *pctx, const char_t *pstr, uint32_t len);
+
+extern status_t
+console_redirect(void *tid, console_out_t out, void *pctx);
+
 #endif /* __DEBUG_H__*/
 /*-----------------------------End of debug.h--------------------------------*/
@@ -58,7 +58,7 @@ typedef struct device
     struct ListNode list;           /**< ͨڵ */
     const struct fileopt *pfileopt; /**< 豸 */
     char_t name[MAX_DEVICE_NAME];   /**< 豸 */
-    SEM_ID lock;                    /**< 豸 */
+    SEM_ID lock;                    /**< 豸, ȼ̳л */
     int32_t serial;                 /**< 豸к */
     int32_t flags;                  /**< 豸ģʽ */
     int32_t offset;                 /**< дƫƵַ */
@@ -39,9 +39,15 @@ dmn_init(uint32_t stacksize);
 extern DMN_ID
 dmn_register(void);
 
+extern DMN_ID
+dmn_register_timeout(uint32_t timeout_ms);
+
 extern status_t
 dmn_sign(DMN_ID id);
 
+extern status_t
+dmn_sign_self(void);
+
 extern status_t
 dmn_unregister(DMN_ID id);
 
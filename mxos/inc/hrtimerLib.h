@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @file       hrtimerLib.h
+ * @brief      API include file of hrtimerLib.h.
+ * @details    This file including all API functions's declare of hrtimerLib.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef __HRTIMERLIB_H__
+#define __HRTIMERLIB_H__
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <types.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define HRTIMER_MAX_US      (0x7FFFFFFFu)   /**< ʱ(us),  */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ʱص, ڱȽжִ, ֻܵÿжʹõĽӿ */
+typedef void (*HRTIMER_FUNC)(void *arg);
+
+/** ߾ȶʱ, ɵ߷, ڲڴ */
+typedef struct
+{
+    uint32_t expires;       /**< ʱ(bsp_timer_get) */
+    uint32_t period;        /**< (us), 0Ϊ */
+    HRTIMER_FUNC func;      /**< ص */
+    void *arg;              /**< ص */
+    int32_t index;          /**< ڶеλ, -1Ϊδ */
+} hrtimer_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern void
+hrtimer_init(hrtimer_t *ptimer, HRTIMER_FUNC func, void *arg);
+
+extern status_t
+hrtimer_start(hrtimer_t *ptimer, uint32_t us, uint32_t period);
+
+extern status_t
+hrtimer_cancel(hrtimer_t *ptimer);
+
+extern bool_e
+hrtimer_active(const hrtimer_t *ptimer);
+
+extern void
+hrtimer_isr(void);
+
+extern void
+hrtimer_show_info(void);
+
+#ifdef HRTIMER_SIM
+extern void
+hrtimer_sim_advance(uint32_t us, uint32_t latency);
+#else
+extern status_t
+taskDelayUs(uint32_t us);
+#endif
+
+#endif /* __HRTIMERLIB_H__ */
+/*---------------------------End of hrtimerLib.h-----------------------------*/
@@ -21,10 +21,24 @@
 //#define intLock()       taskENTER_CRITICAL()
 //#define intUnlock()     taskEXIT_CRITICAL()
 
+/* DWTڼ, ڲжӳٺʱ */
+#define DWT_CTRL        (*(volatile uint32_t *)0xE0001000u) /**< DWT */
+#define DWT_CYCCNT      (*(volatile uint32_t *)0xE0001004u) /**< ڼ */
+#define DWT_CTRL_CYCCNTENA                  (1u)
+
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-/* None */
+#pragma pack(push, 1)
+
+/* жջַISRַ */
+typedef union
+{
+    VOIDFUNCPTR routine;     /**< жϴַ */
+    void *msp;               /**< ջַ         */
+} INTVECT_ITEM;
+
+#pragma pack(pop)
 
 /*-----------------------------------------------------------------------------
  Section: Globals
@@ -55,11 +69,14 @@ intContext (void);
 extern status_t
 intLibInit(void);
 
-extern void
+extern uint32_t
 intLock(void);
 
 extern void
-intUnlock(void);
+intUnlock(uint32_t key);
+
+extern void
+intLockShow(bool_e clear);
 /*-----------------------------------------------------------------------------
  Section: Globals
  ----------------------------------------------------------------------------*/
@@ -0,0 +1,43 @@
+/**
+ ******************************************************************************
+ * @file       logFsLib.h
+ * @brief      API include file of logFsLib.h.
+ * @details    This file including all API functions's declare of logFsLib.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef __LOGFSLIB_H__
+#define __LOGFSLIB_H__
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <types.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+logfs_init(const char_t *pbase, uint32_t stacksize);
+
+extern void
+logfs_show_info(void);
+
+#endif /* __LOGFSLIB_H__ */
+/*-----------------------------End of logFsLib.h-----------------------------*/
@@ -18,17 +18,96 @@
 /*-----------------------------------------------------------------------------
  Section: Macro Definitions
  ----------------------------------------------------------------------------*/
-/* NONE */
+#define LOG_DEFER_MAX_ARGS  (6u)    /**< ӳٸʽ־ */
+
+/**
+ * ͳƿɱ(0~6). ȡLOG_NxǺ, ƴӳLOG_NARGS_LOG_Nxõ
+ * ; 6ʱȡǵ7ʵ, ƴӽδǺϷǺ,
+ * 뱨ǰѵ7.
+ */
+#define LOG_NARGS(...) \
+    LOG_NARGS_(0, ##__VA_ARGS__, LOG_N6, LOG_N5, LOG_N4, LOG_N3, LOG_N2, \
+            LOG_N1, LOG_N0)
+#define LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, N, ...) LOG_NARGS_##N
+#define LOG_NARGS_LOG_N0    (0u)
+#define LOG_NARGS_LOG_N1    (1u)
+#define LOG_NARGS_LOG_N2    (2u)
+#define LOG_NARGS_LOG_N3    (3u)
+#define LOG_NARGS_LOG_N4    (4u)
+#define LOG_NARGS_LOG_N5    (5u)
+#define LOG_NARGS_LOG_N6    (6u)
+
+/**
+ * ӳٸʽ־, ôֻ¼ʽͲ, жʹ.
+ * Ϊ32λָ, %sַָ볤Ч.
+ */
+#define LOGD(fmt, ...) \
+    logdefer((fmt), LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+
+/* ־, ֵԽԽϸ */
+#define LOG_LVL_NONE        (0u)    /**< ر */
+#define LOG_LVL_ERROR       (1u)    /**<  */
+#define LOG_LVL_WARN        (2u)    /**<  */
+#define LOG_LVL_INFO        (3u)    /**< һϢ */
+#define LOG_LVL_DEBUG       (4u)    /**< Ϣ */
+
+/**
+ * ־, ڴ˼LOG_XXX()ͬһ𱻱ɾ.
+ * ڰļǰѡаļ¶.
+ */
+#ifndef LOG_COMPILE_LEVEL
+# define LOG_COMPILE_LEVEL  LOG_LVL_DEBUG
+#endif
+
+/**
+ * ģͼ־. ڱڼʱ䱻ɾ, ģ
+ * мʱֻһαȽ, ʽҲռϢ.
+ */
+#define LOG_PRINT(mod, lvl, fmt, ...) \
+    do { \
+        if (((lvl) <= LOG_COMPILE_LEVEL) && ((lvl) <= _the_log_levels[(mod)])) \
+        { \
+            (void)logmsg((fmt), ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+/** ͬLOG_PRINT, ʹӳٸʽ(LOGD) */
+#define LOG_DEFER(mod, lvl, fmt, ...) \
+    do { \
+        if (((lvl) <= LOG_COMPILE_LEVEL) && ((lvl) <= _the_log_levels[(mod)])) \
+        { \
+            (void)LOGD((fmt), ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_ERROR(mod, fmt, ...)  LOG_PRINT(mod, LOG_LVL_ERROR, fmt, ##__VA_ARGS__)
+#define LOG_WARN(mod, fmt, ...)   LOG_PRINT(mod, LOG_LVL_WARN, fmt, ##__VA_ARGS__)
+#define LOG_INFO(mod, fmt, ...)   LOG_PRINT(mod, LOG_LVL_INFO, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(mod, fmt, ...)  LOG_PRINT(mod, LOG_LVL_DEBUG, fmt, ##__VA_ARGS__)
 
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-/* NONE */
+/** ־ģ, ÿģжм */
+typedef enum
+{
+    LOG_MOD_OS = 0,     /**< ں˼ϵͳ */
+    LOG_MOD_MEM,        /**< ڴ */
+    LOG_MOD_DEV,        /**< 豸 */
+    LOG_MOD_NET,        /**<  */
+    LOG_MOD_FS,         /**< ļϵͳ */
+    LOG_MOD_SHELL,      /**< shell */
+    LOG_MOD_APP,        /**< Ӧ */
+    LOG_MOD_MAX
+} log_module_e;
+
+/** ־Ŀ, logMsgΪλ */
+typedef void (*log_sink_t)(const char_t *pbuf, uint32_t len);
 
 /*-----------------------------------------------------------------------------
  Section: Globals
  ----------------------------------------------------------------------------*/
-/* NONE */
+extern uint8_t _the_log_levels[LOG_MOD_MAX];   /**< ģм */
 
 /*-----------------------------------------------------------------------------
  Section: Function Prototypes
@@ -39,8 +118,17 @@ loglib_init(uint32_t stacksize);
 extern status_t
 logmsg(const char *fmt, ...);
 
+extern status_t
+logdefer(const char *fmt, uint32_t nargs, ...);
+
 extern status_t
 logbuf(const uint8_t *pbuf, uint32_t len);
 
+extern status_t
+loglib_level_set(int32_t mod, uint8_t level);
+
+extern status_t
+loglib_sink_add(log_sink_t sink);
+
 #endif /* __LOGLIB_H__ */
 /*-----------------------------End of logLib.h-------------------------------*/
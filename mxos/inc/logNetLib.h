@@ -0,0 +1,43 @@
+/**
+ ******************************************************************************
+ * @file       logNetLib.h
+ * @brief      API include file of logNetLib.h.
+ * @details    This file including all API functions's declare of logNetLib.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef __LOGNETLIB_H__
+#define __LOGNETLIB_H__
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <types.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+lognet_init(const char_t *pserver, uint16_t port, const char_t *phost);
+
+extern void
+lognet_show_info(void);
+
+#endif /* __LOGNETLIB_H__ */
+/*-----------------------------End of logNetLib.h----------------------------*/
@@ -30,7 +30,12 @@
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-/* NONE */
+/** localtime_r, ͬһڵʱֻӷ */
+typedef struct
+{
+    time_t sec;             /**< Ӧʱ, ʼΪ-1 */
+    struct tm tm;           /**< secӦķֽʱ */
+} tm_cache_t;
 
 /*-----------------------------------------------------------------------------
  Section: Globals
@@ -107,6 +112,11 @@ printf_time(const char_t * pinfo,
 extern void
 print_logtime(void);
 
+extern void
+localtime_cached(tm_cache_t *pcache,
+        time_t sec,
+        struct tm *ptm);
+
 extern void
 printf_frame(const char_t * pfmt,
         const uint8_t * pfrm,
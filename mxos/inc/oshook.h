@@ -71,5 +71,13 @@ extern uint32_t WEAK bsp_get_mcu_clk(void);
 /* 6. ȡMCUж */
 extern uint32_t WEAK bsp_get_max_int_count(void);
 
+/* 7. bspʵָ߾ȶʱȽͨ(hrtimerLib, ǱҪ) */
+
+/* 7.1 bsp_timer_getstampʱж, жеhrtimer_isr; ַ֧ERROR */
+extern status_t WEAK bsp_hrtimer_set(uint32_t stamp);
+
+/* 7.2 رձȽж */
+extern void WEAK bsp_hrtimer_stop(void);
+
 #endif /* __OSHOOK_H__ */
 /*-----------------------------End of oshook.h-------------------------------*/
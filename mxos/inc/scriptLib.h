@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ * @file       scriptLib.h
+ * @brief      API include file of scriptLib.h.
+ * @details    This file including all API functions's declare of scriptLib.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef __SCRIPTLIB_H__
+#define __SCRIPTLIB_H__
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <types.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define SCRIPT_F_ECHO       (0x01u) /**< ִǰÿ */
+#define SCRIPT_F_TIME       (0x02u) /**< ÿĺʱͷֵ */
+#define SCRIPT_F_ERREXIT    (0x04u) /**< ʧ(if)ʱű */
+
+#define SCRIPT_ERR_OPEN       (-2)  /**< űļ򲻿 */
+#define SCRIPT_ERR_SYNTAX     (-3)  /**< ű﷨ */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern int32_t
+script_run(const char_t *ppath, uint32_t argc, const char_t *argv[],
+        uint32_t flags);
+
+#endif /* __SCRIPTLIB_H__ */
+/*----------------------------End of scriptLib.h-----------------------------*/
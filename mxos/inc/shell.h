@@ -41,6 +41,15 @@ typedef uint32_t (*SHELL_CMD_FUNCPTR) (cmd_tbl_t *, uint32_t, const uint8_t *[])
 
 #pragma pack(pop)
 
+/** shellỰ */
+typedef struct shell_io_s shell_io_t;
+struct shell_io_s
+{
+    /** һַ, Ӧȴ; 1: , 0: ȴʱ(ι),
+     *  -1: Ự */
+    int32_t (*getc)(shell_io_t *pio, uint8_t *pch);
+};
+
 #define Struct_Section  __attribute__ ((unused,section (".shell_cmd")))
 
 #ifdef INCLUDE_SHELL
@@ -55,6 +64,10 @@ const cmd_tbl_t __shell_cmd_##name Struct_Section = {#name, maxargs, cmd, usage}
  ----------------------------------------------------------------------------*/
 extern status_t shell_init(uint32_t stacksize);
 
+extern status_t shell_session(shell_io_t *pio);
+
+extern int32_t shell_exec(const char_t *pcmd);
+
 #endif /* __SHELL_H__ */
 
 /*------------------------------End of shell.h-------------------------------*/
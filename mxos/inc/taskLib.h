@@ -19,6 +19,17 @@
  Section: Macro Definitions
  ----------------------------------------------------------------------------*/
 #define WAIT_FOREVER  ((uint32_t)0)
+#define NO_WAIT       ((uint32_t)0xFFFFFFFFu)   /**< ȴ,  */
+#define TASK_TCB_SIZE   (96u)   /**< ̬tcbֽ, СںTCB */
+
+#define SEM_RECURSIVE   (0x01u) /**< semMCreateѡ: ɵݹȡ */
+
+#define MSG_PRI_NORMAL  (0u)    /**< msgQSend: ŵβ */
+#define MSG_PRI_URGENT  (1u)    /**< msgQSend: ŵ */
+
+#define EVENT_WAIT_ANY  (0x00u) /**< eventWait: һ¼λ */
+#define EVENT_WAIT_ALL  (0x01u) /**< eventWait: ȫ¼λ */
+#define EVENT_CLEAR     (0x02u) /**< eventWait: ȴ¼λ */
 
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
@@ -26,6 +37,13 @@
 typedef void * TASK_ID;
 typedef void * SEM_ID;
 typedef void * MSG_Q_ID;
+typedef void * EVENT_ID;
+
+/** taskSpawnStaticɵṩtcb */
+typedef struct
+{
+    uint32_t space[TASK_TCB_SIZE / sizeof(uint32_t)];
+} task_tcb_t;
 
 /*-----------------------------------------------------------------------------
  Section: Globals
@@ -40,6 +58,11 @@ extern TASK_ID
 taskSpawn(const signed char * const name, uint32_t priority,
         uint32_t stackSize, OSFUNCPTR entryPt, uint32_t arg);
 
+extern TASK_ID
+taskSpawnStatic(const signed char * const name, uint32_t priority,
+        void *pstack, uint32_t stackSize, task_tcb_t *ptcb,
+        OSFUNCPTR entryPt, uint32_t arg);
+
 extern void
 taskDelete(TASK_ID tid);
 
@@ -73,6 +96,12 @@ osClkRateGet(void);
 extern SEM_ID
 semBCreate(uint32_t cnt);
 
+extern SEM_ID
+semMCreate(uint32_t options);
+
+extern SEM_ID
+semCCreate(uint32_t cnt, uint32_t max);
+
 extern void
 semDelete(SEM_ID semId);
 
@@ -83,17 +112,52 @@ extern status_t
 semGive(SEM_ID semId);
 
 extern MSG_Q_ID
-msgQCreate(uint32_t msgQLen);
+msgQCreate(uint32_t maxMsgs, uint32_t maxMsgLength);
 
-extern status_t
-msgQSend(MSG_Q_ID msgQId, void *pmsg);
+extern void
+msgQDelete(MSG_Q_ID msgQId);
 
 extern status_t
-msgQReceive(MSG_Q_ID msgQId, uint32_t timeout, void **pmsg);
+msgQSend(MSG_Q_ID msgQId, const void *buffer, uint32_t nBytes,
+        uint32_t timeout, uint32_t priority);
+
+extern int32_t
+msgQReceive(MSG_Q_ID msgQId, void *buffer, uint32_t maxNBytes,
+        uint32_t timeout);
 
 extern int
 msgQNumMsgs(MSG_Q_ID msgQId);
 
+extern EVENT_ID
+eventCreate(uint32_t maxWaiters);
+
+extern void
+eventDelete(EVENT_ID eventId);
+
+extern uint32_t
+eventSet(EVENT_ID eventId, uint32_t bits);
+
+extern uint32_t
+eventClear(EVENT_ID eventId, uint32_t bits);
+
+extern uint32_t
+eventGet(EVENT_ID eventId);
+
+extern status_t
+eventWait(EVENT_ID eventId, uint32_t bits, uint32_t options, uint32_t timeout,
+        uint32_t *pbits);
+
+extern status_t
+taskNotifyGive(TASK_ID tid);
+
+extern uint32_t
+taskNotifyTake(bool_e clear, uint32_t timeout);
+
+extern status_t
+taskNotifySend(TASK_ID tid, uint32_t value, bool_e overwrite);
+
+extern status_t
+taskNotifyReceive(uint32_t *pvalue, uint32_t timeout);
 
 #endif /* __TASKLIB_H__ */
 /*----------------------------End of taskLib.h-------------------------------*/
@@ -0,0 +1,43 @@
+/**
+ ******************************************************************************
+ * @file       telnetLib.h
+ * @brief      API include file of telnetLib.h.
+ * @details    This file including all API functions's declare of telnetLib.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef __TELNETLIB_H__
+#define __TELNETLIB_H__
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <types.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+telnet_init(uint16_t port, uint32_t stacksize);
+
+extern void
+telnet_show_info(void);
+
+#endif /* __TELNETLIB_H__ */
+/*-----------------------------End of telnetLib.h----------------------------*/
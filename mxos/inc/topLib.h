@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ * @file       topLib.h
+ * @brief      API include file of topLib.h.
+ * @details    This file including all API functions's declare of topLib.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef __TOPLIB_H__
+#define __TOPLIB_H__
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <types.h>
+#include <taskLib.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define TOP_NAME_LEN                (8u)    /**< () */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ͳ, CPUռʵλΪ0.01% */
+typedef struct
+{
+    TASK_ID tid;                    /**< ID */
+    char_t name[TOP_NAME_LEN];      /**<  */
+    uint8_t prio;                   /**< ǰȼ */
+    uint8_t state;                  /**< 0 1 2 3 4ɾ */
+    uint16_t cpu_now;               /**< һڵCPUռ */
+    uint16_t cpu_avg;               /**< ڵCPUռ */
+    uint32_t stack_free;            /**< ջʷСʣ(ֽ) */
+} top_task_t;
+
+/** ϵͳͳ */
+typedef struct
+{
+    uint16_t idle_now;              /**< һڵĿ(0.01%) */
+    uint16_t idle_avg;              /**< ڵĿ(0.01%) */
+    uint32_t switches;              /**< ÿл */
+    uint32_t stack_free;            /**< СĶջʣ(ֽ) */
+    uint32_t ntasks;                /**<  */
+    uint32_t window;                /**< ڰĲ */
+} top_sys_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+top_init(uint32_t stacksize);
+
+extern uint32_t
+top_snapshot(top_sys_t *psys, top_task_t *ptasks, uint32_t max);
+
+extern void
+top_show_info(void);
+
+#endif /* __TOPLIB_H__ */
+/*-----------------------------End of topLib.h-------------------------------*/
@@ -14,6 +14,7 @@ Section: Includes
 -----------------------------------------------------------------------------*/
 #include <types.h>
 #include <ring.h>
+#include <taskLib.h>
 /*-----------------------------------------------------------------------------
 Section: Macro Definitions
 -----------------------------------------------------------------------------*/
@@ -35,6 +36,8 @@ Section: Macro Definitions
 #define TTY_BAUD_GET        0x1004
 #define TTY_FIOFLUSH        0x1010
 #define TTY_FIONREAD        0x1011
+#define TTY_FIOCONSOLE      0x1012  /**< Ϊ̨, Ϳʱжϻ */
+#define TTY_FIORXSEM        0x1013  /**< ȡź, argsΪSEM_ID* */
 /*-----------------------------------------------------------------------------
 Section: Type Definitions
 -----------------------------------------------------------------------------*/
@@ -68,6 +71,7 @@ struct tty_exparam
     const tty_opt *popt;
     uint32_t baseregs;
     tty_ring_t ring;
+    SEM_ID rxsem;           /**< ջɿձǿʱͷ, tty_create */
 };
 #pragma pack(pop)
 
@@ -85,6 +89,9 @@ ttylib_getchar(tty_exparam_t *pexparam, uint8_t *pch);
 extern void
 ttylib_putchar(tty_exparam_t *pexparam, uint8_t ch);
 
+extern void
+ttylib_console_kick(void);
+
 extern status_t
 tty_create(uint8_t ttyno, tty_exparam_t *pexparam, uint16_t rdsz, uint16_t wtsz);
 
@@ -0,0 +1,72 @@
+/**
+ ******************************************************************************
+ * @file       workqLib.h
+ * @brief      API include file of workqLib.h.
+ * @details    This file including all API functions's declare of workqLib.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef __WORKQLIB_H__
+#define __WORKQLIB_H__
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <types.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** , workerִ */
+typedef void (*WORK_FUNC)(void *arg);
+
+/** , ɵ߷(ͨΪ̬), ύʱڴ */
+typedef struct work
+{
+    struct work *pnext;         /**<  */
+    WORK_FUNC func;             /**<  */
+    void *arg;                  /**<  */
+    uint32_t stamp;             /**< ύʱ(bsp_timer_get) */
+    volatile bool_e pending;    /**< TRUE: ڶ, ظύϲ */
+} work_t;
+
+typedef struct workq * WORKQ_ID;
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+workq_init(uint32_t stacksize);
+
+extern WORKQ_ID
+workq_create(const char_t *pname, uint32_t priority, uint32_t workers,
+        uint32_t stacksize);
+
+extern void
+work_init(work_t *pwork, WORK_FUNC func, void *arg);
+
+extern status_t
+work_submit(WORKQ_ID wq, work_t *pwork);
+
+extern status_t
+work_cancel(WORKQ_ID wq, work_t *pwork);
+
+extern bool_e
+work_pending(const work_t *pwork);
+
+extern void
+workq_show_info(void);
+
+#endif /* __WORKQLIB_H__ */
+/*----------------------------End of workqLib.h------------------------------*/
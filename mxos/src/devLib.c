@@ -172,9 +172,9 @@ devlib_init(void)
     {
         return OK;
     }
-    if ((the_devlib_lock = semBCreate(1)) == NULL)
+    if ((the_devlib_lock = semMCreate(0u)) == NULL)
     {
-        Dprintf("semBCreate err\n");
+        Dprintf("semMCreate err\n");
         return ERROR;
     }
     InitListHead(&the_dev_list);
@@ -219,7 +219,7 @@ dev_create(const char_t* pname,
     }
 
     memset(new, 0x00, sizeof(struct device));
-    new->lock = semBCreate(1);
+    new->lock = semMCreate(0u);
     if (new->lock == NULL)
     {
         printf("dev_create create sem err.\n");
@@ -16,7 +16,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include <taskLib.h>
-#include <listLib.h>
 #include <dmnLib.h>
 #include <debug.h>
 #include <oshook.h>
@@ -25,20 +24,27 @@
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-#pragma pack(push, 1)
+/** עλ, DMN_IDλַ */
 typedef struct
 {
-    struct ListNode nlist;
-    TASK_ID taskid;
-    int16_t count;
+    volatile uint32_t deadline;     /**< ֹʱ(tick), dmn_signֻд */
+    uint32_t timeout;               /**< ʱʱ(tick) */
+    TASK_ID taskid;                 /**< ע, NULLʾвλ */
 } dmn_t;
-#pragma pack(pop)
 
 /*-----------------------------------------------------------------------------
  Section: Constant Definitions
  ----------------------------------------------------------------------------*/
-#ifndef DMN_MAX_CHECK_TIME
-# define DMN_MAX_CHECK_TIME         (6u)    /**< Ĭιʱʱ䣨6*10룩 */
+#ifndef DMN_DEFAULT_TIMEOUT
+# define DMN_DEFAULT_TIMEOUT    (60000u)    /**< Ĭιʱʱ(ms) */
+#endif
+
+#ifndef DMN_MAX_TASKS
+# define DMN_MAX_TASKS             (16u)    /**< ע */
+#endif
+
+#ifndef DMN_FEED_TICKS
+# define DMN_FEED_TICKS  (TICKS_PER_SECOND) /**< ιӲ(tick) */
 #endif
 
 #ifndef TASK_PRIORITY_DMN
@@ -49,9 +55,9 @@ typedef struct
 # define TASK_STK_SIZE_DMN         (512u)    /**< Ĭջ */
 #endif
 
-#if (DMN_MAX_CHECK_TIME > 10u)
-# error "Plesase set DMN_MAX_CHECK_TIME <= (10u)"
-#endif
+/** tick aǷѵ򳬹tick b(ǻ) */
+#define DMN_TICK_REACHED(a, b)  ((int32_t)((a) - (b)) >= 0)
+
 /*-----------------------------------------------------------------------------
  Section: Global Variables
  ----------------------------------------------------------------------------*/
@@ -60,16 +66,14 @@ bool_e theRebootSignal = FALSE;
 /*-----------------------------------------------------------------------------
  Section: Local Variables
  ----------------------------------------------------------------------------*/
-static struct ListNode the_registed_list;
-static SEM_ID the_dmn_sem = NULL;
+static dmn_t the_dmn_slots[DMN_MAX_TASKS];
+static SEM_ID the_dmn_sem = NULL;       /**< ע/ע */
+static SEM_ID the_dmn_wake = NULL;      /**< עdmn¼ֹʱ */
 static TASK_ID the_dmn_id = NULL;
 
 /*-----------------------------------------------------------------------------
  Section: Local Function Prototypes
  ----------------------------------------------------------------------------*/
-static bool_e
-is_taskname_used(TASK_ID task);
-
 static void
 dmn_loop(void);
 
@@ -93,9 +97,10 @@ dmn_init(uint32_t stacksize)
         return ERROR;
     }
     stacksize = (stacksize == 0) ? TASK_STK_SIZE_DMN : stacksize;
-    InitListHead(&the_registed_list);
-    the_dmn_sem = semBCreate(1);
+    the_dmn_sem = semMCreate(0u);
     D_ASSERT(the_dmn_sem != NULL);
+    the_dmn_wake = semBCreate(0);
+    D_ASSERT(the_dmn_wake != NULL);
     the_dmn_id = taskSpawn((const signed char * const )"daemon",
             TASK_PRIORITY_DMN, stacksize, (OSFUNCPTR)dmn_loop, 0u);
     D_ASSERT(the_dmn_id != NULL);
@@ -105,71 +110,99 @@ dmn_init(uint32_t stacksize)
 
 /**
  ******************************************************************************
- * @brief      ػѰǷظ
- * @param[in]  None
- * @param[out] None
- * @retval     TRUE : Ѵ
- * @retval     FALSE: 
+ * @brief      עIDǷЧ, O(1)
+ * @param[in]  id : עID
+ *
+ * @retval     NULL : ӦĲλ
+ * @retval     NULL   : ЧID
  ******************************************************************************
  */
-static bool_e
-is_taskname_used(TASK_ID taskid)
+static dmn_t *
+dmn_slot(DMN_ID id)
 {
-    dmn_t* pdmn = NULL;
-    struct ListNode *piter = NULL;
+    dmn_t *pdmn = (dmn_t *)id;
+    uint32_t index = (uint32_t)(pdmn - the_dmn_slots);
 
-    LIST_FOR_EACH(piter, &the_registed_list)
+    if ((index >= DMN_MAX_TASKS) || (&the_dmn_slots[index] != pdmn)
+            || (pdmn->taskid == NULL))
     {
-        /* ȡñĶ */
-        pdmn = MemToObj(piter, dmn_t, nlist);
-        if (pdmn->taskid == taskid)
-        {
-            return TRUE;
-        }
+        return NULL;
     }
-    return FALSE;
+    return pdmn;
 }
 
 /**
  ******************************************************************************
- * @brief   ػע
- * @param[in]  None
- * @param[out] None
+ * @brief   ػע, ָʱʱ
+ * @param[in]  timeout_ms : ʱʱ(ms), 0ʹDMN_DEFAULT_TIMEOUT
  *
  * @retval     NULL : ʧ
  * @retval  !  NULL : עID
  ******************************************************************************
  */
 DMN_ID
-dmn_register(void)
+dmn_register_timeout(uint32_t timeout_ms)
 {
+    TASK_ID taskid = taskIdSelf();
+    dmn_t *pnew = NULL;
+    uint32_t ticks;
+    uint32_t i;
+
     if (the_dmn_id == NULL)
     {
         return NULL;
     }
-    TASK_ID taskid = taskIdSelf();
-    if (TRUE == is_taskname_used(taskid))
+    timeout_ms = (timeout_ms == 0u) ? DMN_DEFAULT_TIMEOUT : timeout_ms;
+    ticks = ((timeout_ms * TICKS_PER_SECOND) + 999u) / 1000u;
+
+    semTake(the_dmn_sem, WAIT_FOREVER);
+    for (i = 0u; i < DMN_MAX_TASKS; i++)
     {
-        printf("err %s already registered!\n", taskName(taskid));
-        return NULL;
+        if (the_dmn_slots[i].taskid == taskid)
+        {
+            semGive(the_dmn_sem);
+            printf("err %s already registered!\n", taskName(taskid));
+            return NULL;
+        }
+        if ((pnew == NULL) && (the_dmn_slots[i].taskid == NULL))
+        {
+            pnew = &the_dmn_slots[i];
+        }
     }
-    dmn_t *pnew = malloc(sizeof(dmn_t));
-    if (NULL == pnew)
+    if (pnew != NULL)
     {
-        return NULL;
+        pnew->timeout = (ticks == 0u) ? 1u : ticks;
+        pnew->deadline = tickGet() + pnew->timeout;
+        pnew->taskid = taskid;
     }
-    pnew->taskid = taskid;
-    pnew->count = DMN_MAX_CHECK_TIME;
-    semTake(the_dmn_sem, WAIT_FOREVER);
-    ListAddTail(&pnew->nlist, &the_registed_list);
     semGive(the_dmn_sem);
 
+    if (pnew != NULL)
+    {
+        (void)semGive(the_dmn_wake);  /* ½ֹʱܸ̿ */
+    }
     return (DMN_ID)pnew;
 }
 
 /**
  ******************************************************************************
- * @brief   ػι
+ * @brief   ػע, ʹĬϳʱʱ
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     NULL : ʧ
+ * @retval  !  NULL : עID
+ ******************************************************************************
+ */
+DMN_ID
+dmn_register(void)
+{
+    return dmn_register_timeout(0u);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ػι, ֻ½ֹʱ, ʹź
  * @param[in]  id   : ιעʱصid
  *
  * @retval     OK   : ιɹ
@@ -179,30 +212,42 @@ dmn_register(void)
 status_t
 dmn_sign(DMN_ID id)
 {
-    dmn_t *pdmn = (dmn_t *)id;
+    dmn_t *pdmn = dmn_slot(id);
 
-    if (the_dmn_id == NULL)
+    if (pdmn == NULL)
     {
         return ERROR;
     }
 
-    semTake(the_dmn_sem, WAIT_FOREVER);
+    /* ֵд, dmnҪôǾֵҪôֵ */
+    pdmn->deadline = tickGet() + pdmn->timeout;
 
-#if 1
-    if (FALSE == is_taskname_used(pdmn->taskid))
-    {
-        semGive(the_dmn_sem);
-        return ERROR;
-    }
-#endif
+    return OK;
+}
 
-    if (pdmn->count > 0u)
+/**
+ ******************************************************************************
+ * @brief   Ϊǰι, ڲעIDĹ(shellű)
+ * @param[in]  None
+ *
+ * @retval     OK   : ιɹ
+ * @retval     ERROR: ǰδע
+ ******************************************************************************
+ */
+status_t
+dmn_sign_self(void)
+{
+    TASK_ID taskid = taskIdSelf();
+    uint32_t i;
+
+    for (i = 0u; i < DMN_MAX_TASKS; i++)
     {
-        pdmn->count = DMN_MAX_CHECK_TIME;
+        if (the_dmn_slots[i].taskid == taskid)
+        {
+            return dmn_sign((DMN_ID)&the_dmn_slots[i]);
+        }
     }
-    semGive(the_dmn_sem);
-
-    return OK;
+    return ERROR;
 }
 
 /**
@@ -216,7 +261,7 @@ dmn_sign(DMN_ID id)
 status_t
 dmn_unregister(DMN_ID id)
 {
-    dmn_t *pdmn = (dmn_t *)id;
+    dmn_t *pdmn;
 
     if (the_dmn_id == NULL)
     {
@@ -224,17 +269,14 @@ dmn_unregister(DMN_ID id)
     }
 
     semTake(the_dmn_sem, WAIT_FOREVER);
-    if (FALSE == is_taskname_used(id))
+    pdmn = dmn_slot(id);
+    if (pdmn != NULL)
     {
-        semGive(the_dmn_sem);
-        return ERROR;
+        pdmn->taskid = NULL;
     }
-
-    ListDelNode(&pdmn->nlist);
     semGive(the_dmn_sem);
-    free(pdmn);
 
-    return OK;
+    return (pdmn != NULL) ? OK : ERROR;
 }
 
 /**
@@ -248,25 +290,31 @@ dmn_unregister(DMN_ID id)
 void
 dmn_info(bool_e is_sem)
 {
-    dmn_t *pdmn = NULL;
-    struct ListNode *piter = NULL;
+    uint32_t now = tickGet();
+    int32_t remain;
+    uint32_t i;
 
     if (the_dmn_id == NULL)
     {
         printf("Task: DMN is not running!\n");
         return ;
     }
-    printf("\n  Name\r\t\t\tRemainCounts\n");
+    printf("\n  Name\r\t\t\tTimeout(ms)\tRemain(ms)\n");
 
     if (is_sem == TRUE)
     {
         semTake(the_dmn_sem, WAIT_FOREVER);
     }
-    LIST_FOR_EACH(piter, &the_registed_list)
+    for (i = 0u; i < DMN_MAX_TASKS; i++)
     {
-        /* ȡñĶ */
-        pdmn = MemToObj(piter, dmn_t, nlist);
-        printf("  %s\r\t\t\t%d\n", taskName(pdmn->taskid), pdmn->count);
+        if (the_dmn_slots[i].taskid == NULL)
+        {
+            continue;
+        }
+        remain = (int32_t)(the_dmn_slots[i].deadline - now);
+        printf("  %s\r\t\t\t%u\t\t%d\n", taskName(the_dmn_slots[i].taskid),
+                (the_dmn_slots[i].timeout * 1000u) / TICKS_PER_SECOND,
+                (remain * 1000) / (int32_t)TICKS_PER_SECOND);
     }
     if (is_sem == TRUE)
     {
@@ -292,6 +340,31 @@ dmn_reboot(void)
     theRebootSignal = TRUE;
 }
 
+/**
+ ******************************************************************************
+ * @brief   ιʱ, λϵͳ
+ * @param[in]  pdmn : ʱĲλ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+dmn_expired(const dmn_t *pdmn)
+{
+    printf("\n  TASK(%s) Sign Out Of Time!\n", taskName(pdmn->taskid));
+    dmn_info(FALSE);
+    printf("  dmn reboot system...\n");
+    if (_func_dmnRestHook != NULL)
+    {
+        _func_dmnRestHook();    /* ι쳣 */
+    }
+    if (_func_cpuRestHook != NULL)
+    {
+        _func_cpuRestHook();    /* reset CPU */
+    }
+    bsp_reboot();
+}
+
 /**
  ******************************************************************************
  * @brief   dmnִ
@@ -299,57 +372,55 @@ dmn_reboot(void)
  * @param[out] None
  *
  * @retval     None
+ *
+ * @details ÿвλĽֹʱ, Ȼ˯ߵĽֹʱ̻
+ *          һιӲʱ. dmn_signֻƳٽֹʱ, 軽;
+ *          עʱֹʱ̿ǰ, the_dmn_wake.
  ******************************************************************************
  */
 static void
 dmn_loop(void)
 {
-    uint32_t tick = tickGet();
-    dmn_t *pdmn = NULL;
-    struct ListNode *piter = NULL;
+    uint32_t feed = tickGet();
+    uint32_t now;
+    uint32_t wake;
+    uint32_t deadline;
+    uint32_t i;
 
     theRebootSignal = FALSE;
 
     FOREVER
     {
-        taskDelay(TICKS_PER_SECOND);
-        if (_func_feedDogHook != NULL)
-        {
-            _func_feedDogHook();    /* ιӲ */
-        }
-        if ((tickGet() - tick) < (TICKS_PER_SECOND * 10))
+        now = tickGet();
+        if (DMN_TICK_REACHED(now, feed))
         {
-            continue;
+            if (_func_feedDogHook != NULL)
+            {
+                _func_feedDogHook();    /* ιӲ */
+            }
+            feed = now + DMN_FEED_TICKS;
         }
-        tick = tickGet();
-        semTake(the_dmn_sem, WAIT_FOREVER);
-        LIST_FOR_EACH(piter, &the_registed_list)
+
+        wake = feed;
+        for (i = 0u; i < DMN_MAX_TASKS; i++)
         {
-            /* ȡñĶ */
-            pdmn = MemToObj(piter, dmn_t, nlist);
-            if (pdmn->count >= 0)
+            if (the_dmn_slots[i].taskid == NULL)
             {
-                pdmn->count--;
+                continue;
             }
-            if (pdmn->count == 0)
+            deadline = the_dmn_slots[i].deadline;
+            if (DMN_TICK_REACHED(now, deadline))
             {
-                printf("\n  TASK(%s) Sign Out Of Time!\n",
-                        taskName(pdmn->taskid));
-                dmn_info(FALSE);
-                printf("  dmn reboot system...\n");
-                if (_func_dmnRestHook != NULL)
-                {
-                    _func_dmnRestHook();    /* ι쳣 */
-                }
-                if (_func_cpuRestHook != NULL)
-                {
-                    _func_cpuRestHook();    /* reset CPU */
-                }
-                bsp_reboot();
+                dmn_expired(&the_dmn_slots[i]);
+            }
+            else if (!DMN_TICK_REACHED(deadline, wake))
+            {
+                wake = deadline;
             }
-
         }
-        semGive(the_dmn_sem);
+
+        /* wakenow, ʱΪ0(WAIT_FOREVER) */
+        (void)semTake(the_dmn_wake, wake - now);
     }
     printf("dmn will reboot system after 10s...\n");
     /* wait a moment */
@@ -16,6 +16,7 @@
 #include <string.h>
 #include <time.h>
 #include <taskLib.h>
+#include <debug.h>
 #include <FreeRTOS.h>
 #include <task.h>
 
@@ -38,7 +39,7 @@
 /*-----------------------------------------------------------------------------
  Section: Global Variables
  ----------------------------------------------------------------------------*/
-extern int32_t intCnt;
+/* NONE */
 
 /*-----------------------------------------------------------------------------
  Section: Function Prototypes
@@ -103,7 +104,7 @@ excExcHandle(void* pregs,
     memcpy(regs, pregs, 64);
     uint32_t sp = (uint32_t)pregs;
 
-    intCnt++;
+    console_panic(TRUE);    /* 쳣ͬ, жϺ͵ */
     printf("\r\n");
     switch (excno)
     {
@@ -146,7 +147,7 @@ excExcHandle(void* pregs,
             break;
         default:
             printf("=====ЧĴж:%d=====\r\n", excno);
-            intCnt--;
+            console_panic(FALSE);
             return;
     }
 
@@ -176,7 +177,7 @@ excExcHandle(void* pregs,
     {
         xTaskResumeAll();
     }
-    intCnt--;
+    console_panic(FALSE);
 }
 
 /*----------------------------End of excLib.c--------------------------------*/
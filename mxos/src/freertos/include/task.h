@@ -105,6 +105,16 @@ typedef enum
 	eDeleted		/* The task being queried has been deleted, but its TCB has not yet been freed. */
 } eTaskState;
 
+/* Actions that can be performed when xTaskGenericNotify() is called. */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without updating its notify value. */
+	eSetBits,					/* Set bits in the task's notification value. */
+	eIncrement,					/* Increment the task's notification value. */
+	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
+	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+} eNotifyAction;
+
 /*
  * Used internally only.
  */
@@ -1344,6 +1354,96 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  */
 void vTaskGetRunTimeStats( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction );</PRE>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be defined as 1 for this function to be
+ * available.
+ *
+ * Each task has a 32-bit notification value and a notification state held in
+ * its TCB.  Sending a notification updates the value according to eAction and
+ * unblocks the receiving task if it is blocked in xTaskNotifyWait() or
+ * ulTaskNotifyTake().  No queue or semaphore object is involved, so a
+ * notification is faster than a semaphore give and uses no extra RAM.  A task
+ * can only be notified directly, so there is never more than one receiver.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param ulValue Used to update the notification value, see eAction.
+ *
+ * @param eAction eSetBits ORs ulValue into the value, eIncrement adds one to
+ * it (ulValue is not used), eSetValueWithOverwrite stores ulValue
+ * unconditionally, eSetValueWithoutOverwrite stores ulValue only if the task
+ * has no notification pending, and eNoAction only unblocks the task.
+ *
+ * @return pdFAIL if eAction is eSetValueWithoutOverwrite and the task
+ * already had a notification pending, otherwise pdPASS.
+ *
+ * \defgroup xTaskGenericNotify xTaskGenericNotify
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ) )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0UL ), eIncrement )
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskGenericNotify() that can be called from an interrupt
+ * service routine.  *pxHigherPriorityTaskWoken is set to pdTRUE if the
+ * notification unblocked a task with a priority above the running task, in
+ * which case a context switch should be requested before the interrupt
+ * exits.
+ *
+ * \defgroup xTaskGenericNotifyFromISR xTaskGenericNotifyFromISR
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) ( void ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( 0UL ), eIncrement, ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );</PRE>
+ *
+ * Wait, optionally with a timeout, for the calling task to be notified.
+ *
+ * @param ulBitsToClearOnEntry Bits cleared in the notification value before
+ * waiting if no notification is pending.
+ *
+ * @param ulBitsToClearOnExit Bits cleared in the notification value after it
+ * has been copied to *pulNotificationValue, if a notification was received.
+ *
+ * @param pulNotificationValue Receives the notification value.  May be NULL.
+ *
+ * @param xTicksToWait Maximum time to wait in the Blocked state.
+ *
+ * @return pdTRUE if a notification was received, otherwise pdFALSE.
+ *
+ * \defgroup xTaskNotifyWait xTaskNotifyWait
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );</PRE>
+ *
+ * Use the notification value as a light weight binary or counting semaphore.
+ * The calling task blocks while the value is zero.  On exit the value is
+ * either cleared (xClearCountOnExit != pdFALSE, binary semaphore) or
+ * decremented (counting semaphore).
+ *
+ * @return The notification value before it was cleared or decremented, so 0
+ * means the wait timed out.
+ *
+ * \defgroup ulTaskNotifyTake ulTaskNotifyTake
+ * \ingroup TaskNotifications
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
  *----------------------------------------------------------*/
@@ -1476,6 +1576,15 @@ void vTaskPriorityDisinherit( xTaskHandle const pxMutexHolder ) PRIVILEGED_FUNCT
  */
 signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * Create a task using a stack and TCB provided by the caller instead of the
+ * heap.  xTCBBufferSize must be at least the size of the kernel TCB, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY is returned.  Neither buffer is freed
+ * when the task is deleted; a deleted task's buffers may only be reused once
+ * the idle task has cleaned it up.
+ */
+signed portBASE_TYPE xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, void *pvTCBBuffer, size_t xTCBBufferSize ) PRIVILEGED_FUNCTION;
+
 /*
  * Get the uxTCBNumber assigned to the task referenced by the xTask parameter.
  */
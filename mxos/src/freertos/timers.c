@@ -92,6 +92,18 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 /* Misc definitions. */
 #define tmrNO_DELAY		( portTickType ) 0U
 
+/* The number of commands the timer service task takes from the timer queue
+before sampling the tick count and applying them. */
+#define tmrCOMMAND_BATCH	( ( unsigned portBASE_TYPE ) 8U )
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+	#if ( ( configTIMER_WHEEL_SIZE & ( configTIMER_WHEEL_SIZE - 1 ) ) != 0 )
+		#error configTIMER_WHEEL_SIZE must be a power of two.
+	#endif
+
+	#define tmrWHEEL_MASK	( ( portTickType ) configTIMER_WHEEL_SIZE - ( portTickType ) 1U )
+#endif
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl
 {
@@ -115,13 +127,31 @@ typedef struct tmrTimerQueueMessage
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access xActiveTimerList. */
-PRIVILEGED_DATA static xList xActiveTimerList1;
-PRIVILEGED_DATA static xList xActiveTimerList2;
-PRIVILEGED_DATA static xList *pxCurrentTimerList;
-PRIVILEGED_DATA static xList *pxOverflowTimerList;
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	/* Hashed timing wheel.  A timer that expires at tick t is held, unsorted,
+	in slot ( t & tmrWHEEL_MASK ), so starting, stopping and resetting a timer
+	are all O(1).  For every tick the timer service task walks one slot and
+	fires the timers whose expiry time is that tick.  Timers that are one or
+	more revolutions away share the slot and are skipped.  Expiry times are
+	compared as signed differences, so no list switch is needed when the tick
+	count overflows.  Only the timer service task is allowed to access the
+	wheel. */
+	PRIVILEGED_DATA static xList xTimerWheel[ configTIMER_WHEEL_SIZE ];
+	PRIVILEGED_DATA static portTickType xWheelTime = ( portTickType ) 0U;			/*<< The last tick for which the wheel has been processed. */
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxWheelTimers = ( unsigned portBASE_TYPE ) 0U; /*<< The number of timers in the wheel. */
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in expire
+	time order, with the nearest expiry time at the front of the list.  Only the
+	timer service task is allowed to access xActiveTimerList. */
+	PRIVILEGED_DATA static xList xActiveTimerList1;
+	PRIVILEGED_DATA static xList xActiveTimerList2;
+	PRIVILEGED_DATA static xList *pxCurrentTimerList;
+	PRIVILEGED_DATA static xList *pxOverflowTimerList;
+
+#endif
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
@@ -162,16 +192,38 @@ static void	prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
+ * Remove the timer from the active timer list or wheel.
  */
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvRemoveTimerFromActiveList( xTIMER *pxTimer ) PRIVILEGED_FUNCTION;
 
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
- */
-static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Add the timer to the wheel slot of its expiry time.
+	 */
+	static void prvWheelInsert( xTIMER *pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Advance the wheel up to xTimeNow, reloading and calling back every timer
+	 * that expires on the way.
+	 */
+	static void prvProcessExpiredTimers( portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is an
+	 * auto reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -317,6 +369,61 @@ xTIMER_MESSAGE xMessage;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+static void prvWheelInsert( xTIMER *pxTimer )
+{
+	vListInsertEnd( &( xTimerWheel[ listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) & tmrWHEEL_MASK ] ), &( pxTimer->xTimerListItem ) );
+	uxWheelTimers++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessExpiredTimers( portTickType xTimeNow )
+{
+xList *pxSlot;
+xListItem *pxItem, *pxNext;
+xTIMER *pxTimer;
+
+	while( ( uxWheelTimers > ( unsigned portBASE_TYPE ) 0U ) && ( xWheelTime != xTimeNow ) )
+	{
+		xWheelTime++;
+		pxSlot = &( xTimerWheel[ xWheelTime & tmrWHEEL_MASK ] );
+
+		/* Callbacks cannot change the wheel directly (commands go through the
+		timer queue), and reloaded timers are appended to the end of a slot,
+		so walking the slot while removing from it is safe. */
+		pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;
+		while( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )
+		{
+			pxNext = ( xListItem * ) pxItem->pxNext;
+
+			if( listGET_LIST_ITEM_VALUE( pxItem ) == xWheelTime )
+			{
+				pxTimer = ( xTIMER * ) listGET_LIST_ITEM_OWNER( pxItem );
+				prvRemoveTimerFromActiveList( pxTimer );
+				traceTIMER_EXPIRED( pxTimer );
+
+				if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+				{
+					/* Reload relative to the expiry time, not the time now,
+					so the period does not drift. */
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), ( xWheelTime + pxTimer->xTimerPeriodInTicks ) );
+					prvWheelInsert( pxTimer );
+				}
+
+				pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+			}
+
+			pxItem = pxNext;
+		}
+	}
+
+	/* Nothing left to walk past, jump straight to the time now. */
+	xWheelTime = xTimeNow;
+}
+
+#else
+
 static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
 {
 xTIMER *pxTimer;
@@ -351,6 +458,8 @@ portBASE_TYPE xResult;
 	/* Call the timer callback. */
 	pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvTimerTask( void *pvParameters )
@@ -377,6 +486,39 @@ portBASE_TYPE xListWasEmpty;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty )
+{
+portTickType xTimeNow;
+
+	vTaskSuspendAll();
+	{
+		xTimeNow = xTaskGetTickCount();
+
+		if( ( xListWasEmpty == pdFALSE ) && ( ( portBASE_TYPE ) ( xNextExpireTime - xTimeNow ) <= ( portBASE_TYPE ) 0 ) )
+		{
+			/* All the timers that expired up to now are processed in one pass
+			rather than one per loop of the timer task. */
+			( void ) xTaskResumeAll();
+			prvProcessExpiredTimers( xTimeNow );
+		}
+		else
+		{
+			/* Block until the next occupied slot comes round or a command is
+			received.  With an empty wheel only a command can do anything. */
+			vQueueWaitForMessageRestricted( xTimerQueue, ( xListWasEmpty == pdFALSE ) ? ( xNextExpireTime - xTimeNow ) : portMAX_DELAY );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+		}
+	}
+}
+
+#else
+
 static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty )
 {
 portTickType xTimeNow;
@@ -424,8 +566,37 @@ portBASE_TYPE xTimerListsWereSwitched;
 		}
 	}
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
+{
+portTickType xTicks = ( portTickType ) 0U;
+
+	/* The first occupied slot after xWheelTime gives the earliest time at
+	which a timer can expire.  Its timers may be whole revolutions away, in
+	which case the task wakes, finds nothing to do and looks again.  The scan
+	is bounded by configTIMER_WHEEL_SIZE. */
+	*pxListWasEmpty = ( uxWheelTimers == ( unsigned portBASE_TYPE ) 0U ) ? pdTRUE : pdFALSE;
+	if( *pxListWasEmpty == pdFALSE )
+	{
+		for( xTicks = ( portTickType ) 1U; xTicks < ( portTickType ) configTIMER_WHEEL_SIZE; xTicks++ )
+		{
+			if( listLIST_IS_EMPTY( &( xTimerWheel[ ( xWheelTime + xTicks ) & tmrWHEEL_MASK ] ) ) == pdFALSE )
+			{
+				break;
+			}
+		}
+	}
+
+	return xWheelTime + xTicks;
+}
+
+#else
+
 static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
 {
 portTickType xNextExpireTime;
@@ -450,8 +621,23 @@ portTickType xNextExpireTime;
 
 	return xNextExpireTime;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
+{
+	/* The wheel compares expiry times as signed differences and does not
+	need to switch lists on overflow. */
+	*pxTimerListsWereSwitched = pdFALSE;
+
+	return xTaskGetTickCount();
+}
+
+#else
+
 static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
 {
 portTickType xTimeNow;
@@ -473,8 +659,45 @@ PRIVILEGED_DATA static portTickType xLastTime = ( portTickType ) 0U; /*lint !e95
 
 	return xTimeNow;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
+{
+portBASE_TYPE xProcessTimerNow = pdFALSE;
+
+	( void ) xCommandTime;
+
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+	if( uxWheelTimers == ( unsigned portBASE_TYPE ) 0U )
+	{
+		/* Nothing to walk past, bring the wheel up to date. */
+		xWheelTime = xTimeNow;
+	}
+
+	if( ( portBASE_TYPE ) ( xNextExpiryTime - xWheelTime ) <= ( portBASE_TYPE ) 0 )
+	{
+		/* The wheel has already passed the expiry time, which elapsed between
+		the command being issued and being processed. */
+		xProcessTimerNow = pdTRUE;
+	}
+	else
+	{
+		/* Expiry times between xWheelTime and xTimeNow are picked up the next
+		time the wheel is advanced. */
+		prvWheelInsert( pxTimer );
+	}
+
+	return xProcessTimerNow;
+}
+
+#else
+
 static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
 {
 portBASE_TYPE xProcessTimerNow = pdFALSE;
@@ -514,86 +737,123 @@ portBASE_TYPE xProcessTimerNow = pdFALSE;
 
 	return xProcessTimerNow;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+static void prvRemoveTimerFromActiveList( xTIMER *pxTimer )
+{
+	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+	#if ( configUSE_TIMER_WHEEL == 1 )
+	{
+		uxWheelTimers--;
+	}
+	#endif
+}
 /*-----------------------------------------------------------*/
 
 static void	prvProcessReceivedCommands( void )
 {
-xTIMER_MESSAGE xMessage;
+xTIMER_MESSAGE xMessages[ tmrCOMMAND_BATCH ];
+xTIMER_MESSAGE *pxMessage;
 xTIMER *pxTimer;
 portBASE_TYPE xTimerListsWereSwitched, xResult;
 portTickType xTimeNow;
+unsigned portBASE_TYPE uxCount, ux;
 
-	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	for( ;; )
 	{
-		pxTimer = xMessage.pxTimer;
-
-		if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+		/* Take up to tmrCOMMAND_BATCH commands from the queue, then sample the
+		time once for all of them.  prvSampleTimeNow() must be called after the
+		messages are received from xTimerQueue so there is no possibility of a
+		higher priority task adding a message to the message queue with a time
+		that is ahead of the timer daemon task (because it pre-empted the timer
+		daemon task after the xTimeNow value was set). */
+		for( uxCount = ( unsigned portBASE_TYPE ) 0U; uxCount < tmrCOMMAND_BATCH; uxCount++ )
 		{
-			/* The timer is in a list, remove it. */
-			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			if( xQueueReceive( xTimerQueue, &( xMessages[ uxCount ] ), tmrNO_DELAY ) == pdFAIL )
+			{
+				break;
+			}
 		}
 
-		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.xMessageValue );
+		if( uxCount == ( unsigned portBASE_TYPE ) 0U )
+		{
+			break;
+		}
 
-		/* In this case the xTimerListsWereSwitched parameter is not used, but 
-		it must be present in the function call.  prvSampleTimeNow() must be 
-		called after the message is received from xTimerQueue so there is no 
-		possibility of a higher priority task adding a message to the message
-		queue with a time that is ahead of the timer daemon task (because it
-		pre-empted the timer daemon task after the xTimeNow value was set). */
+		/* In this case the xTimerListsWereSwitched parameter is not used, but
+		it must be present in the function call. */
 		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
-		switch( xMessage.xMessageID )
+		for( ux = ( unsigned portBASE_TYPE ) 0U; ux < uxCount; ux++ )
 		{
-			case tmrCOMMAND_START :
-				/* Start or restart a timer. */
-				if( prvInsertTimerInActiveList( pxTimer,  xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.xMessageValue ) == pdTRUE )
-				{
-					/* The timer expired before it was added to the active timer
-					list.  Process it now. */
-					pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
-
-					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
-					{
-						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-						configASSERT( xResult );
-						( void ) xResult;
-					}
-				}
-				break;
-
-			case tmrCOMMAND_STOP :
-				/* The timer has already been removed from the active list.
-				There is nothing to do here. */
-				break;
+			pxMessage = &( xMessages[ ux ] );
+			pxTimer = pxMessage->pxTimer;
 
-			case tmrCOMMAND_CHANGE_PERIOD :
-				pxTimer->xTimerPeriodInTicks = xMessage.xMessageValue;
-				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-				/* The new period does not really have a reference, and can be
-				longer or shorter than the old one.  The command time is 
-				therefore set to the current time, and as the period cannot be
-				zero the next expiry time can only be in the future, meaning
-				(unlike for the xTimerStart() case above) there is no fail case
-				that needs to be handled here. */
-				( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-				break;
+			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+			{
+				/* The timer is in a list, remove it. */
+				prvRemoveTimerFromActiveList( pxTimer );
+			}
 
-			case tmrCOMMAND_DELETE :
-				/* The timer has already been removed from the active list,
-				just free up the memory. */
-				vPortFree( pxTimer );
-				break;
+			traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->xMessageValue );
 
-			default	:
-				/* Don't expect to get here. */
-				break;
+			switch( pxMessage->xMessageID )
+			{
+				case tmrCOMMAND_START :
+					/* Start or restart a timer. */
+					if( prvInsertTimerInActiveList( pxTimer,  pxMessage->xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->xMessageValue ) == pdTRUE )
+					{
+						/* The timer expired before it was added to the active timer
+						list.  Process it now. */
+						pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+
+						if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+						{
+							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, pxMessage->xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+							configASSERT( xResult );
+							( void ) xResult;
+						}
+					}
+					break;
+
+				case tmrCOMMAND_STOP :
+					/* The timer has already been removed from the active list.
+					There is nothing to do here. */
+					break;
+
+				case tmrCOMMAND_CHANGE_PERIOD :
+					pxTimer->xTimerPeriodInTicks = pxMessage->xMessageValue;
+					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+					/* The new period does not really have a reference, and can be
+					longer or shorter than the old one.  The command time is 
+					therefore set to the current time, and as the period cannot be
+					zero the next expiry time can only be in the future, meaning
+					(unlike for the xTimerStart() case above) there is no fail case
+					that needs to be handled here. */
+					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+					break;
+
+				case tmrCOMMAND_DELETE :
+					/* The timer has already been removed from the active list,
+					just free up the memory. */
+					vPortFree( pxTimer );
+					break;
+
+				default	:
+					/* Don't expect to get here. */
+					break;
+			}
 		}
 	}
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists( portTickType xLastTime )
 {
 portTickType xNextExpireTime, xReloadTime;
@@ -649,6 +909,8 @@ portBASE_TYPE xResult;
 	pxCurrentTimerList = pxOverflowTimerList;
 	pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -660,10 +922,23 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if ( configUSE_TIMER_WHEEL == 1 )
+			{
+			unsigned portBASE_TYPE ux;
+
+				for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configTIMER_WHEEL_SIZE; ux++ )
+				{
+					vListInitialise( &( xTimerWheel[ ux ] ) );
+				}
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif
 			xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
 		}
 	}
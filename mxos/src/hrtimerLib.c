@@ -0,0 +1,588 @@
+/**
+ ******************************************************************************
+ * @file      hrtimerLib.c
+ * @brief     ʵ΢뼶߾ȶʱ.
+ * @details   bsp_timer_get΢Ϊʱ, BSPıȽͨ
+ *            (bsp_hrtimer_set)絽ʱ̲ж, жеhrtimer_isr
+ *            ִеڻص. ʱʱ̴С, /ȡΪ
+ *            O(log n), жֻѶ. ʱ̱ȽϰзŲֵ, ƺ
+ *            Ȼȷ.
+ *            HRTIMER_SIMBSP, 
+ *            hrtimer_sim_advanceƽʱ, Իص˳Ͷ.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <types.h>
+#include <hrtimerLib.h>
+#ifndef HRTIMER_SIM
+#include <FreeRTOS.h>
+#include <task.h>
+#include <taskLib.h>
+#include <intLib.h>
+#include <udelay.h>
+#include <oshook.h>
+#include <shell.h>
+#include <oscfg.h>
+#endif
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef HRTIMER_MAX
+# define HRTIMER_MAX               (16u)    /**< ͬʱĶʱ */
+#endif
+
+#ifndef HRTIMER_MIN_US
+# define HRTIMER_MIN_US             (5u)    /**< Ƚֵȵǰus */
+#endif
+
+#ifndef HRTIMER_SPIN_US
+# define HRTIMER_SPIN_US           (50u)    /**< taskDelayUsСڴֵʱæ */
+#endif
+
+/* ȽжϵȼܸconfigMAX_SYSCALL_INTERRUPT_PRIORITY */
+#ifdef HRTIMER_SIM
+# define HRT_LOCK(key)      ((key) = 0u)
+# define HRT_UNLOCK(key)    ((void)(key))
+#else
+# define HRT_LOCK(key)      ((key) = intLock())
+# define HRT_UNLOCK(key)    intUnlock(key)
+#endif
+
+/** ab֮ǰ(), ƺȻ */
+#define HRT_BEFORE(a, b)    ((int32_t)((a) - (b)) <= 0)
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef HRTIMER_SIM
+/** taskDelayUsĵȴ */
+typedef struct
+{
+    TASK_ID tid;                /**< ȴ */
+    volatile bool_e done;       /**< ʱѵ */
+} hrtimer_delay_t;
+#endif
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static hrtimer_t *the_hrtimer_heap[HRTIMER_MAX];   /**< ʱ̵С */
+static uint32_t the_hrtimer_num = 0u;
+
+/* ͳ */
+static uint32_t the_hrtimer_fires = 0u;     /**< ص */
+static uint32_t the_hrtimer_overruns = 0u;  /**< ڶʱ */
+static uint32_t the_hrtimer_max_late = 0u;  /**< صԵʱ̵ӳ(us) */
+static uint32_t the_hrtimer_peak = 0u;      /**< ͬʱĶʱ */
+
+#ifdef HRTIMER_SIM
+static uint32_t the_sim_now = 0u;           /**< ģ΢ */
+static uint32_t the_sim_cmp = 0u;           /**< ģıȽֵ */
+static bool_e the_sim_armed = FALSE;        /**< Ƚͨʹ */
+#endif
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+#ifdef HRTIMER_SIM
+/**
+ ******************************************************************************
+ * @brief   ģ: ȡ΢
+ * @param[in]  None
+ *
+ * @retval     ǰ
+ ******************************************************************************
+ */
+uint32_t
+bsp_timer_get(void)
+{
+    return the_sim_now;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ģ: ñȽֵ. Ӳһ, ѴıȽֵж
+ * @param[in]  stamp : Ƚֵ
+ *
+ * @retval     OK
+ ******************************************************************************
+ */
+status_t
+bsp_hrtimer_set(uint32_t stamp)
+{
+    the_sim_cmp = stamp;
+    the_sim_armed = HRT_BEFORE(stamp, the_sim_now) ? FALSE : TRUE;
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ģ: رձȽͨ
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+bsp_hrtimer_stop(void)
+{
+    the_sim_armed = FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ģ: ƽʱ, Ƚֵʱģжϵhrtimer_isr
+ * @param[in]  us      : ƽʱ(us)
+ * @param[in]  latency : ģжӦӳ(us), ڲԶͳ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+hrtimer_sim_advance(uint32_t us, uint32_t latency)
+{
+    uint32_t start = the_sim_now;
+
+    while ((the_sim_armed == TRUE) && ((the_sim_cmp - start) <= us))
+    {
+        the_sim_armed = FALSE;
+        the_sim_now = the_sim_cmp + latency;
+        hrtimer_isr();
+    }
+    if ((the_sim_now - start) < us)
+    {
+        the_sim_now = start + us;
+    }
+}
+#endif
+
+/**
+ ******************************************************************************
+ * @brief   
+ * @param[in]  i : λ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+hrtimer_sift_up(uint32_t i)
+{
+    hrtimer_t *pt = the_hrtimer_heap[i];
+    uint32_t parent;
+
+    while (i > 0u)
+    {
+        parent = (i - 1u) / 2u;
+        if (HRT_BEFORE(the_hrtimer_heap[parent]->expires, pt->expires))
+        {
+            break;
+        }
+        the_hrtimer_heap[i] = the_hrtimer_heap[parent];
+        the_hrtimer_heap[i]->index = (int32_t)i;
+        i = parent;
+    }
+    the_hrtimer_heap[i] = pt;
+    pt->index = (int32_t)i;
+}
+
+/**
+ ******************************************************************************
+ * @brief   
+ * @param[in]  i : λ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+hrtimer_sift_down(uint32_t i)
+{
+    hrtimer_t *pt = the_hrtimer_heap[i];
+    uint32_t child;
+
+    while ((child = (2u * i) + 1u) < the_hrtimer_num)
+    {
+        if (((child + 1u) < the_hrtimer_num)
+                && !HRT_BEFORE(the_hrtimer_heap[child]->expires,
+                        the_hrtimer_heap[child + 1u]->expires))
+        {
+            child++;
+        }
+        if (HRT_BEFORE(pt->expires, the_hrtimer_heap[child]->expires))
+        {
+            break;
+        }
+        the_hrtimer_heap[i] = the_hrtimer_heap[child];
+        the_hrtimer_heap[i]->index = (int32_t)i;
+        i = child;
+    }
+    the_hrtimer_heap[i] = pt;
+    pt->index = (int32_t)i;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ӷɾʱ
+ * @param[in]  pt : ڶеĶʱ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+hrtimer_heap_remove(hrtimer_t *pt)
+{
+    uint32_t i = (uint32_t)pt->index;
+    hrtimer_t *plast = the_hrtimer_heap[--the_hrtimer_num];
+
+    pt->index = -1;
+    if (plast == pt)
+    {
+        return;
+    }
+    the_hrtimer_heap[i] = plast;
+    plast->index = (int32_t)i;
+    if ((i > 0u) && HRT_BEFORE(plast->expires,
+            the_hrtimer_heap[(i - 1u) / 2u]->expires))
+    {
+        hrtimer_sift_up(i);
+    }
+    else
+    {
+        hrtimer_sift_down(i);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ѶñȽͨ, HRT_LOCKڵ
+ * @param[in]  None
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : BSPֱ֧Ƚͨ
+ *
+ * @details ȽֵȵǰHRTIMER_MIN_US, дѴıȽֵ
+ *          ʧж, ǵڹĶʱHRTIMER_MIN_USִ.
+ ******************************************************************************
+ */
+static status_t
+hrtimer_program(void)
+{
+    uint32_t now;
+    uint32_t when;
+
+    if (the_hrtimer_num == 0u)
+    {
+        bsp_hrtimer_stop();
+        return OK;
+    }
+    when = the_hrtimer_heap[0]->expires;
+    now = bsp_timer_get();
+    if ((int32_t)(when - now) < (int32_t)HRTIMER_MIN_US)
+    {
+        when = now + HRTIMER_MIN_US;
+    }
+    return bsp_hrtimer_set(when);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʼʱ
+ * @param[in]  ptimer : ʱ
+ * @param[in]  func   : ڻص, жִ
+ * @param[in]  arg    : ص
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+hrtimer_init(hrtimer_t *ptimer, HRTIMER_FUNC func, void *arg)
+{
+    ptimer->expires = 0u;
+    ptimer->period = 0u;
+    ptimer->func = func;
+    ptimer->arg = arg;
+    ptimer->index = -1;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʱ, ¼ʱ
+ * @param[in]  ptimer : ʱ
+ * @param[in]  us     : ״εʱ(us), HRTIMER_MAX_US
+ * @param[in]  period : (us), 0Ϊ, 0ʱСHRTIMER_MIN_US
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : , ʱBSPֱ֧Ƚͨ
+ *
+ * @details же. ڶʱʱۼ, ۻصӳ.
+ ******************************************************************************
+ */
+status_t
+hrtimer_start(hrtimer_t *ptimer, uint32_t us, uint32_t period)
+{
+    uint32_t key;
+
+    if ((ptimer == NULL) || (ptimer->func == NULL) || (us > HRTIMER_MAX_US)
+            || (period > HRTIMER_MAX_US)
+            || ((period != 0u) && (period < HRTIMER_MIN_US)))
+    {
+        return ERROR;
+    }
+
+    HRT_LOCK(key);
+    if (ptimer->index >= 0)
+    {
+        hrtimer_heap_remove(ptimer);
+    }
+    else if (the_hrtimer_num >= HRTIMER_MAX)
+    {
+        HRT_UNLOCK(key);
+        return ERROR;
+    }
+    ptimer->expires = bsp_timer_get() + us;
+    ptimer->period = period;
+    the_hrtimer_heap[the_hrtimer_num] = ptimer;
+    hrtimer_sift_up(the_hrtimer_num++);
+    if (the_hrtimer_num > the_hrtimer_peak)
+    {
+        the_hrtimer_peak = the_hrtimer_num;
+    }
+
+    if ((ptimer->index == 0) && (hrtimer_program() != OK))
+    {
+        /* BSPûбȽͨ */
+        hrtimer_heap_remove(ptimer);
+        HRT_UNLOCK(key);
+        return ERROR;
+    }
+    HRT_UNLOCK(key);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡʱ
+ * @param[in]  ptimer : ʱ
+ *
+ * @retval  OK    : ȡ
+ * @retval  ERROR : ʱδ򵥴ζʱѵ
+ *
+ * @details же, Ҳصȡڶʱ.
+ ******************************************************************************
+ */
+status_t
+hrtimer_cancel(hrtimer_t *ptimer)
+{
+    uint32_t key;
+    bool_e top;
+
+    HRT_LOCK(key);
+    if (ptimer->index < 0)
+    {
+        HRT_UNLOCK(key);
+        return ERROR;
+    }
+    top = (ptimer->index == 0) ? TRUE : FALSE;
+    hrtimer_heap_remove(ptimer);
+    if (top == TRUE)
+    {
+        (void)hrtimer_program();
+    }
+    HRT_UNLOCK(key);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʱǷڵȴ
+ * @param[in]  ptimer : ʱ
+ *
+ * @retval  TRUE  : δ
+ * @retval  FALSE : δѵ
+ ******************************************************************************
+ */
+bool_e
+hrtimer_active(const hrtimer_t *ptimer)
+{
+    return (ptimer->index >= 0) ? TRUE : FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ƚжϴ, BSPıȽͨжϵ
+ * @param[in]  None
+ *
+ * @retval     None
+ *
+ * @details ִѵڵĻص, صڼ䲻ж. ڶʱڻص
+ *          ǰ, صпȡ. 󳬹һʱ,
+ *          .
+ ******************************************************************************
+ */
+void
+hrtimer_isr(void)
+{
+    hrtimer_t *pt;
+    HRTIMER_FUNC func;
+    void *arg;
+    uint32_t now;
+    uint32_t late;
+    uint32_t key;
+
+    HRT_LOCK(key);
+    for (;;)
+    {
+        now = bsp_timer_get();
+        if ((the_hrtimer_num == 0u)
+                || !HRT_BEFORE(the_hrtimer_heap[0]->expires, now))
+        {
+            break;
+        }
+        pt = the_hrtimer_heap[0];
+        late = now - pt->expires;
+        if (late > the_hrtimer_max_late)
+        {
+            the_hrtimer_max_late = late;
+        }
+        the_hrtimer_fires++;
+
+        hrtimer_heap_remove(pt);
+        if (pt->period != 0u)
+        {
+            pt->expires += pt->period;
+            if (HRT_BEFORE(pt->expires, now))
+            {
+                the_hrtimer_overruns += (now - pt->expires) / pt->period + 1u;
+                pt->expires = now + pt->period;
+            }
+            the_hrtimer_heap[the_hrtimer_num] = pt;
+            hrtimer_sift_up(the_hrtimer_num++);
+        }
+        func = pt->func;
+        arg = pt->arg;
+
+        HRT_UNLOCK(key);
+        func(arg);
+        HRT_LOCK(key);
+    }
+    (void)hrtimer_program();
+    HRT_UNLOCK(key);
+}
+
+#ifndef HRTIMER_SIM
+/**
+ ******************************************************************************
+ * @brief   taskDelayUsĶʱص, ѵȴ
+ * @param[in]  arg : hrtimer_delay_t
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+hrtimer_wake(void *arg)
+{
+    hrtimer_delay_t *pdelay = (hrtimer_delay_t *)arg;
+    signed portBASE_TYPE woken = pdFALSE;
+
+    pdelay->done = TRUE;
+    /* eNoAction: ıֵ֪ͨ, taskNotifyGiveļӰ */
+    (void)xTaskGenericNotifyFromISR(pdelay->tid, 0u, eNoAction, &woken);
+    portEND_SWITCHING_ISR(woken);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ˯ָ΢
+ * @param[in]  us : ʱ(us), HRTIMER_MAX_US
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : 
+ *
+ * @details HRTIMER_SPIN_US(л)жеʱæ; ø߾
+ *          ʱ, ȴڼóCPU. ʱBSPֱ֧Ƚͨʱ˻
+ *          ΪtickȡtaskDelay.
+ *
+ * @note    ȴʹ֪ͨ, ȡڼ䵽taskNotifySend״̬
+ ******************************************************************************
+ */
+status_t
+taskDelayUs(uint32_t us)
+{
+    hrtimer_t timer;
+    hrtimer_delay_t delay;
+    uint32_t tick_us = 1000000u / TICKS_PER_SECOND;
+
+    if (us > HRTIMER_MAX_US)
+    {
+        return ERROR;
+    }
+    if ((us < HRTIMER_SPIN_US) || (intContext() == TRUE)
+            || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+    {
+        _usleep(us);
+        return OK;
+    }
+
+    delay.tid = taskIdSelf();
+    delay.done = FALSE;
+    hrtimer_init(&timer, hrtimer_wake, &delay);
+    if (hrtimer_start(&timer, us, 0u) != OK)
+    {
+        taskDelay((us + tick_us - 1u) / tick_us);
+        return OK;
+    }
+    while (delay.done == FALSE)
+    {
+        (void)xTaskNotifyWait(0u, 0u, NULL, portMAX_DELAY);
+    }
+
+    return OK;
+}
+#endif
+
+/**
+ ******************************************************************************
+ * @brief   ߾ȶʱ״̬
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+hrtimer_show_info(void)
+{
+    printf("  HRTIMER INFOMATION\n");
+    printf("active:%u  peak:%u  max:%u\n", the_hrtimer_num, the_hrtimer_peak,
+            HRTIMER_MAX);
+    printf("fires:%u  overruns:%u  max late:%uus\n", the_hrtimer_fires,
+            the_hrtimer_overruns, the_hrtimer_max_late);
+    printf("\n");
+}
+
+#ifndef HRTIMER_SIM
+/*SHELL CMD FOR HRTIMER*/
+uint32_t
+do_hrtimer(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    if ((argc == 2) && (argv[1][0] == 'c'))
+    {
+        the_hrtimer_max_late = 0u;
+        the_hrtimer_overruns = 0u;
+        the_hrtimer_peak = the_hrtimer_num;
+    }
+    hrtimer_show_info();
+    return 0;
+}
+
+SHELL_CMD(hrtimer, 2, do_hrtimer, "hrtimer [c] -- show (c: clear) hrtimer state\r\n");
+#endif
+
+/*-------------------------------hrtimerLib.c--------------------------------*/
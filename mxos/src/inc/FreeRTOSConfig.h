@@ -102,12 +102,25 @@
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
 
 #define configUSE_MUTEXES				1
-#define configUSE_COUNTING_SEMAPHORES 	0
+#define configUSE_COUNTING_SEMAPHORES 	1
 #define configUSE_ALTERNATIVE_API 		0
 #define configCHECK_FOR_STACK_OVERFLOW	2
 #define configUSE_RECURSIVE_MUTEXES		1
 #define configQUEUE_REGISTRY_SIZE		0
 #define configGENERATE_RUN_TIME_STATS	1
+#define configUSE_TASK_NOTIFICATIONS	1
+
+/* Software timer definitions. The timer task and its command queue are
+only created when INCLUDE_SOFT_TIMERS is set in oscfg.h. */
+#ifndef INCLUDE_SOFT_TIMERS
+	#define INCLUDE_SOFT_TIMERS			(0u)
+#endif
+#define configUSE_TIMERS				INCLUDE_SOFT_TIMERS
+#define configUSE_TIMER_WHEEL			1
+#define configTIMER_WHEEL_SIZE			64
+#define configTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH		16
+#define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -150,6 +163,10 @@ interrupt count respectively. */
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() bsp_timer_start()
 #define portGET_RUN_TIME_COUNTER_VALUE()    bsp_timer_get()
 
+/* Count context switches for the task monitor (topLib). */
+extern volatile unsigned long _the_task_switches;
+#define traceTASK_SWITCHED_IN()     ( _the_task_switches++ )
+
 
 #endif /* FREERTOS_CONFIG_H */
 
@@ -35,18 +35,89 @@ Section: Macro Definitions
 /* shell */
 #define TASK_PRIORITY_SHELL         (2u)    /**< shellȼ */
 #define TASK_STK_SIZE_SHELL      (2048u)    /**< shellջ */
+#define SHELL_IDLE_TICKS          (100u)    /**< shellʱĵȴʱ */
+#define SHELL_STARTUP_SCRIPT   "0:/STARTUP.SH" /**< ʱִеĽű,  */
+#define CFG_CBSIZE                 (50u)    /**< ֽ */
+
+/* shellű */
+#define SCRIPT_LINE_SIZE    (CFG_CBSIZE)    /**< ű󳤶, CFG_CBSIZE */
+#define SCRIPT_MAX_VARS             (8u)    /**< ÿűı */
+#define SCRIPT_MAX_NEST             (4u)    /**< ifǶײ */
+#define SCRIPT_MAX_DEPTH            (2u)    /**< ÿsourceǶ׵Ĳ */
+#define SCRIPT_MAX_TASKS            (4u)    /**< ͬʱִнű */
 
 /* dmn */
 #define TASK_PRIORITY_DMN           (1u)    /**< DMNȼ */
 #define TASK_STK_SIZE_DMN         (512u)    /**< DMNջ */
-#define DMN_MAX_CHECK_TIME          (6u)    /**< Ĭιʱʱ䣨6*10룩 */
+#define DMN_DEFAULT_TIMEOUT     (60000u)    /**< Ĭιʱʱ(ms) */
+#define DMN_MAX_TASKS              (16u)    /**< ע */
 
 /* logMsg */
 #define INCLUDE_LOGMSG_SUPPORT      (1u)    /**< ֧logMsg */
-#define MAX_MSGS                   (10u)    /**< ϢеϢ */
+#define MAX_MSGS                   (16u)    /**< ԤϢ(2) */
 #define MAX_BYTES_IN_A_MSG        (200u)    /**< 1logMsgӡֽ */
 #define TASK_PRIORITY_LOGMSG        (1u)    /**< logMsg */
 #define TASK_STK_SIZE_LOGMSG     (1024u)    /**< logMsgĶջС */
+#define LOG_DEFER_RECS            (64u)    /**< ӳٸʽ־¼(2) */
+#define LOG_BATCH_SIZE           (256u)    /**< logMsgС */
+#define LOG_DEFAULT_LEVEL           (3u)    /**< ģĬ־(LOG_LVL_INFO) */
+
+/* logFs */
+#define TASK_PRIORITY_LOGFS         (1u)    /**< ־ļдȼ */
+#define TASK_STK_SIZE_LOGFS      (1024u)    /**< ־ļдջ */
+#define LOGFS_BUFS                  (4u)    /**< СĴ仺 */
+#define LOGFS_FILE_SIZE   (256u * 1024u)    /**< ־ļС */
+#define LOGFS_FILES                 (4u)    /**< ־ļ */
+#define LOGFS_SYNC_SECONDS          (5u)    /**< f_sync() */
+#define LOGFS_SYNC_SECTORS         (16u)    /**< дf_sync */
+
+/* logNet */
+#define LOGNET_DGRAM_SIZE         (512u)    /**< ־UDP󳤶 */
+#define LOGNET_BUFS                 (2u)    /**< ־UDPĻ */
+#define LOGNET_RATE                (20u)    /**< ÿ෢͵־ */
+
+/* telnet */
+#define TASK_PRIORITY_TELNET        (2u)    /**< telnetȼ */
+#define TASK_STK_SIZE_TELNETD     (512u)    /**< telnetջ */
+#define TASK_STK_SIZE_TELNET     (2048u)    /**< telnetỰջ */
+#define TELNET_MAX_SESSIONS         (1u)    /**< Ự(MEMP_NUM_NETCONN) */
+#define TELNET_TX_SIZE            (512u)    /**< ỰͻС */
+#define CONSOLE_REDIRECTS           (2u)    /**< ض */
+
+/* TaskMon */
+#define TASK_PRIORITY_TOP           (1u)    /**< ȼ */
+#define TASK_STK_SIZE_TOP         (512u)    /**< ջ */
+#define TOP_MAX_TASKS              (16u)    /**< ͳƵ */
+#define TOP_SAMPLE_TICKS          (100u)    /**< (tick) */
+#define TOP_WINDOW                 (10u)    /**< ڰĲ */
+
+/* hrtimer */
+#define HRTIMER_MAX                (16u)    /**< ͬʱĸ߾ȶʱ */
+#define HRTIMER_MIN_US              (5u)    /**< Ƚֵȵǰus */
+#define HRTIMER_SPIN_US            (50u)    /**< taskDelayUsСڴֵʱæ */
+
+/* workqueue */
+#define TASK_PRIORITY_WORKQ         (0u)    /**< ϵͳȼ() */
+#define TASK_STK_SIZE_WORKQ       (512u)    /**< ϵͳջ */
+#define WORKQ_WORKERS               (1u)    /**< ϵͳworker */
+#define WORKQ_MAX                   (4u)    /**< ഴĹ */
+
+/* ж */
+/* 1ʱintLibInitƵRAMVTOR, ޲ISRֱд,
+   ʡȥroutineN/intHandlerַ; ռ512ֽRAM, intLib.c */
+#define INCLUDE_INT_VECTOR_RAM      (0u)    /**< RAM, ޲ISRֱд */
+#define INCLUDE_INT_BENCH           (0u)    /**< intbenchжӳٲ */
+#define INCLUDE_NOTIFY_BENCH        (0u)    /**< notifybenchжϻӳٲ */
+#define INCLUDE_INT_LOCK_STAT       (0u)    /**< ͳintLockʱ() */
+
+/* ʱ */
+#define INCLUDE_SOFT_TIMERS         (0u)    /**< FreeRTOSʱ */
+#define INCLUDE_TIMER_BENCH         (0u)    /**< tmrbenchܲ */
+
+/* printf */
+#define INCLUDE_PRINTF_FLOAT        (1u)    /**< ֧%fʽ */
+#define INCLUDE_PRINTF_BENCH        (0u)    /**< printfbenchܲ */
+#define CONSOLE_ISR_RING_SIZE     (512u)    /**< жprintf(2) */
 
 #if (CORE_TYPE == CORE_CM4) && (SUPPORT_FPU == 1)
 # define __FPU_PRESENT        1
@@ -6,6 +6,18 @@
  *          ļṩӲƽ̨صжϽӿںԹ
  *          ϵͳжϴκC Գܹͨú
  *          intConnect()ָĺҽӵָжϡ
+ *
+ *          INCLUDE_INT_VECTOR_RAMΪ1ʱintLibInitƵRAM޸
+ *          VTOR, ޲ISRintConnectֱд, жڲپ
+ *          startup.croutineNintHandler; вISRдroutineN,
+ *          intHandlerȡò.
+ *          ѡĬϹر(жϾroutineNַ, ǰͬ). 򿪷:
+ *          oscfg.hаINCLUDE_INT_VECTOR_RAMΪ1u, RAM512ֽ
+ *          (INT_VECTOR_ALIGN)Ŀռ, intLibInitʹжǰ.
+ *
+ *          intLockֻBASEPRIߵconfigMAX_SYSCALL_INTERRUPT_PRIORITY,
+ *          ȼڴֵҲϵͳӿڵжڼճӦ.
+ *          intLockԭֵ, intUnlockָ, ǶʱҪ.
  * @copyright
  *
  ******************************************************************************
@@ -15,15 +27,33 @@
  Section: Includes
  ----------------------------------------------------------------------------*/
 #include <types.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <oscfg.h>
 #include <oshook.h>
+#include <intLib.h>
+#include <shell.h>
+#include <FreeRTOS.h>
 #if CORE_TYPE == CORE_CM3
 #include <core_cm3.h>
 #elif  CORE_TYPE == CORE_CM4
 #include <core_cm4.h>
 #endif
 
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef INCLUDE_INT_VECTOR_RAM
+# define INCLUDE_INT_VECTOR_RAM     (0u)    /**< flash */
+#endif
+
+#define INT_VECTOR_NUM            (104u)    /**< startup.c */
+#define INT_VECTOR_ALIGN          (512u)    /**< VTORҪ󰴱С2ݶ */
+
+#ifndef INCLUDE_INT_LOCK_STAT
+# define INCLUDE_INT_LOCK_STAT      (0u)    /**< ͳintLockʱ */
+#endif
+
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
@@ -47,13 +77,25 @@ typedef struct int_rtn
  ----------------------------------------------------------------------------*/
 /* жʵֺڱ */
 INT_RTN *intRtnTbl = NULL;
-/* Counter to tell if we are at interrupt (non-task) level. */
-int32_t intCnt = 0;
 
 /*-----------------------------------------------------------------------------
  Section: Local Variables
  ----------------------------------------------------------------------------*/
-/* NONE */
+#if (INCLUDE_INT_VECTOR_RAM == 1u)
+/* flashе, startup.c */
+extern const INTVECT_ITEM __vector_table[];
+
+/* RAMе */
+static volatile INTVECT_ITEM the_int_vectors[INT_VECTOR_NUM]
+        __attribute__((aligned(INT_VECTOR_ALIGN)));
+#endif
+
+#if (INCLUDE_INT_LOCK_STAT == 1u)
+static uint32_t the_lock_start;     /**< intLockʱڼ */
+static uint32_t the_lock_max;       /**< ʱ() */
+static uint32_t the_lock_max_pc;    /**< ʱintUnlockλ */
+static uint32_t the_lock_count;     /**< intLock */
+#endif
 
 /*-----------------------------------------------------------------------------
  Section: Global Function Prototypes
@@ -76,14 +118,12 @@ int32_t intCnt = 0;
 void
 intHandler(uint32_t irq_num)
 {
-    intCnt++;
-    INT_RTN int_rtn = intRtnTbl[irq_num - 16];
+    const INT_RTN *prtn = &intRtnTbl[irq_num - 16];
 
-    if (0 != int_rtn.parameter)
-        int_rtn.routine(int_rtn.parameter);
+    if (0 != prtn->parameter)
+        prtn->routine(prtn->parameter);
     else
-        int_rtn.routine();
-    if(intCnt > 0) intCnt--;
+        prtn->routine();
 }
 
 /* dummy interrupt handler */
@@ -96,7 +136,8 @@ dummy(void);
  *          ļṩӲƽ̨صжϽӿںԹ
  *          ϵͳжϴκC Գܹͨú
  *          intConnect()ָĺҽӵָжϡ
- *          ܹͨintLock()intUnlock()򿪺͹رжϡ
+ *          ܹͨintLock()intUnlock()κͻָɵϵͳ
+ *          ӿڵжϡ
  *
  * @{
  */
@@ -110,6 +151,9 @@ dummy(void);
  *
  * @retval  OK   : ɹ
  * @retval  ERROR: ʧ
+ *
+ * @details RAMʱ, parameterΪ0routineֱд, Ӳ
+ *          ֱӵ.
  ******************************************************************************
  */
 extern status_t
@@ -126,6 +170,16 @@ intConnect(uint32_t irq_num, VOIDFUNCPTR routine, uint32_t parameter)
     intRtnTbl[irq_num - 16].routine = routine;
     intRtnTbl[irq_num - 16].parameter = parameter;
 
+#if (INCLUDE_INT_VECTOR_RAM == 1u)
+    if (irq_num < INT_VECTOR_NUM)
+    {
+        /* ȸintRtnTblд, лнжҵroutine */
+        the_int_vectors[irq_num].routine = (parameter == 0u) ? routine
+                : __vector_table[irq_num].routine;
+        __asm volatile ("DSB\n" ::: "memory");
+    }
+#endif
+
     return OK;
 }
 
@@ -142,19 +196,7 @@ intConnect(uint32_t irq_num, VOIDFUNCPTR routine, uint32_t parameter)
 extern status_t
 intDisconnect(uint32_t irq_num)
 {
-    if (intRtnTbl == NULL)
-    {
-        return ERROR;
-    }
-    if ((irq_num < 16) || (irq_num > MAX_INT_COUNT))
-    {
-        return ERROR;
-    }
-
-    intRtnTbl[irq_num - 16].routine = dummy;
-    intRtnTbl[irq_num - 16].parameter = 0;
-
-    return OK;
+    return intConnect(irq_num, dummy, 0);
 }
 
 /**
@@ -236,13 +278,21 @@ intDisable(uint32_t irq_num)
  *
  * @retval  TRUE : 
  * @retval  FALSE: 
+ *
+ * @details IPSR0쳣, δintHandlerֱӹϵж;
+ *          intLockٽ(BASEPRI0)ͬΪж״̬, ʱ.
  ******************************************************************************
  */
 bool_e
 intContext (void)
 {
     extern unsigned long getNesting( void );
-    if ((intCnt > 0) || (0 < getNesting()))
+    uint32_t ipsr;
+    uint32_t basepri;
+
+    __asm volatile ("MRS %0, IPSR\n" : "=r" (ipsr));
+    __asm volatile ("MRS %0, BASEPRI\n" : "=r" (basepri));
+    if ((ipsr != 0u) || (basepri != 0u) || (0 < getNesting()))
     {
         return TRUE;
     }
@@ -269,6 +319,17 @@ intLibInit(void)
         {
             return ERROR;
         }
+#if (INCLUDE_INT_VECTOR_RAM == 1u)
+        // ƵRAM, ֮intConnectֱ޸
+        for (irq_num = 0; irq_num < INT_VECTOR_NUM; irq_num++)
+        {
+            the_int_vectors[irq_num].msp = __vector_table[irq_num].msp;
+        }
+        __asm volatile ("DSB\n" ::: "memory");
+        SCB->VTOR = (uint32_t)the_int_vectors;
+        __asm volatile ("DSB\n"
+                        "ISB\n" ::: "memory");
+#endif
         // ʼжϱ
         for (irq_num = 16; irq_num < MAX_INT_COUNT; irq_num++)
         {
@@ -280,6 +341,10 @@ intLibInit(void)
                 | SCB_SHCSR_USGFAULTENA_Msk
                 | SCB_SHCSR_MEMFAULTENA_Msk);
         SCB->CCR |= SCB_CCR_DIV_0_TRP_Msk;  /* ʹܳΪ0쳣 */
+#if (INCLUDE_INT_LOCK_STAT == 1u)
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;     /* ʱڼ */
+#endif
 
     }
     return OK;
@@ -288,38 +353,118 @@ intLibInit(void)
 
 /**
  ******************************************************************************
- * @brief      ж
+ * @brief      οɵϵͳӿڵж
  * @param[in]  None
  *
+ * @retval     ԭBASEPRI, intUnlockָ
+ *
+ * @details BASEPRI_MAXֻ߲μ, жмʱǶ
+ *          . ȼconfigMAX_SYSCALL_INTERRUPT_PRIORITYжϲ
+ *          , ҲܵintLock.
+ ******************************************************************************
+ */
+uint32_t
+intLock(void)
+{
+    uint32_t key;
+
+    __asm volatile ("MRS %0, BASEPRI\n" : "=r" (key));
+    __asm volatile ("MSR BASEPRI_MAX, %0\n"
+                    "ISB\n"
+                    :: "r" (configMAX_SYSCALL_INTERRUPT_PRIORITY) : "memory");
+#if (INCLUDE_INT_LOCK_STAT == 1u)
+    if (key == 0u)
+    {
+        the_lock_start = DWT_CYCCNT;
+    }
+#endif
+
+    return key;
+}
+
+/**
+ ******************************************************************************
+ * @brief      ָintLockǰж.
+ * @param[in]  key : intLockķֵ
+ *
  * @retval     None
  ******************************************************************************
  */
 void
-intLock(void)
+intUnlock(uint32_t key)
 {
-    __asm(
-            "CPSID   I\n"
-            "CPSID   I\n"
-         );
-    intCnt++;
+#if (INCLUDE_INT_LOCK_STAT == 1u)
+    uint32_t cycles;
+
+    if (key == 0u)
+    {
+        cycles = DWT_CYCCNT - the_lock_start;
+        the_lock_count++;
+        if (cycles > the_lock_max)
+        {
+            the_lock_max = cycles;
+            the_lock_max_pc = (uint32_t)__builtin_return_address(0);
+        }
+    }
+#endif
+    __asm volatile ("MSR BASEPRI, %0\n" :: "r" (key) : "memory");
 }
 
+#if (INCLUDE_INT_LOCK_STAT == 1u)
 /**
  ******************************************************************************
- * @brief      ж.
- * @param[in]  None
+ * @brief      intLockʱ
+ * @param[in]  clear : TRUEͳ
  *
  * @retval     None
  ******************************************************************************
  */
 void
-intUnlock(void)
+intLockShow(bool_e clear)
 {
-    intCnt--;
-    __asm(
-            "CPSIE   I\n"
-         );
+    uint32_t key;
+    uint32_t max;
+    uint32_t pc;
+    uint32_t count;
+    uint32_t mhz = MCU_CLOCK / 1000000u;
+
+    key = intLock();
+    max = the_lock_max;
+    pc = the_lock_max_pc;
+    count = the_lock_count;
+    if (clear == TRUE)
+    {
+        the_lock_max = 0u;
+        the_lock_max_pc = 0u;
+        the_lock_count = 0u;
+    }
+    intUnlock(key);
+
+    printf("  INTLOCK INFOMATION\n");
+    printf("locks      : %u\n", count);
+    printf("max masked : %u cycles (%u us)\n", max,
+            (mhz != 0u) ? (max / mhz) : 0u);
+    printf("unlock at  : 0x%08x\n\n", pc);
 }
+
+/*SHELL CMD FOR INTLOCK*/
+uint32_t
+do_intlock(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    intLockShow(((argc > 1u) && (argv[1][0] == 'c')) ? TRUE : FALSE);
+    return 0;
+}
+
+SHELL_CMD(intlock, 2, do_intlock, "intlock [c] -- show (c: clear) max masked time\r\n");
+#else
+void
+intLockShow(bool_e clear)
+{
+    (void)clear;
+    printf("intLock statistics disabled (INCLUDE_INT_LOCK_STAT)\n");
+}
+#endif
+
 /**
 * @}
 */
@@ -0,0 +1,153 @@
+/**
+ ******************************************************************************
+ * @file       intbench.c
+ * @brief      жӳٲ.
+ * @details    һежϺNVIC->STIRж, DWTڼ
+ *             ӴISRһ. ֱв(routineN
+ *             intHandler)޲(INCLUDE_INT_VECTOR_RAMΪ1ʱֱд)
+ *             ʽҽ, ԱڵĿ. STIRдͶĹ̶
+ *             , ַʽͬ.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <types.h>
+#include <shell.h>
+#include <intLib.h>
+#include <oshook.h>
+#include <oscfg.h>
+#if CORE_TYPE == CORE_CM3
+#include <core_cm3.h>
+#elif  CORE_TYPE == CORE_CM4
+#include <core_cm4.h>
+#endif
+
+#ifndef INCLUDE_INT_BENCH
+# define INCLUDE_INT_BENCH          (0u)    /**< жӳٲ */
+#endif
+
+#if (INCLUDE_INT_BENCH == 1u)
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define INTBENCH_LOOPS            (100u)    /**< ÿַʽ */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static volatile uint32_t the_intbench_stamp;
+static volatile bool_e the_intbench_done;
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief      ISR, ¼ʱ
+ ******************************************************************************
+ */
+static void
+intbench_isr(void)
+{
+    the_intbench_stamp = DWT_CYCCNT;
+    the_intbench_done = TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief      һֹҽӷʽжϲӳ
+ * @param[in]  pname     : ʽ
+ * @param[in]  irq_num   : жϺ
+ * @param[in]  parameter : intConnect, 0intHandler
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+intbench_run(const char *pname, uint32_t irq_num, uint32_t parameter)
+{
+    uint32_t i;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t min = 0xFFFFFFFFu;
+    uint32_t max = 0u;
+    uint32_t sum = 0u;
+
+    (void)intConnect(irq_num, (VOIDFUNCPTR)intbench_isr, parameter);
+    for (i = 0u; i < INTBENCH_LOOPS; i++)
+    {
+        the_intbench_done = FALSE;
+        start = DWT_CYCCNT;
+        NVIC->STIR = irq_num - 16u;
+        while (the_intbench_done == FALSE)
+        {
+            ;
+        }
+        cycles = the_intbench_stamp - start;
+        sum += cycles;
+        if (cycles < min)
+        {
+            min = cycles;
+        }
+        if (cycles > max)
+        {
+            max = cycles;
+        }
+    }
+
+    printf("%-8s %6u %6u %6u cycles\n", pname, min,
+            sum / INTBENCH_LOOPS, max);
+}
+
+/**
+ ******************************************************************************
+ * @brief      intbench: жӳ
+ * @param[in]  argv[1] : õĿжϺ(16 ~ MAX_INT_COUNT)
+ *
+ * @retval     0
+ ******************************************************************************
+ */
+uint32_t
+do_intbench(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    uint32_t irq_num;
+
+    (void)cmdtp;
+    if (argc < 2u)
+    {
+        printf("usage: intbench <unused irq>\n");
+        return 1;
+    }
+    irq_num = (uint32_t)strtoul((const char *)argv[1], NULL, 0);
+    if ((irq_num < 16u) || (irq_num > MAX_INT_COUNT))
+    {
+        printf("irq must be 16 ~ %u\n", MAX_INT_COUNT);
+        return 1;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    printf("intbench: irq %u, vector table in %s\n", irq_num,
+            (INCLUDE_INT_VECTOR_RAM == 1u) ? "ram" : "flash");
+    printf("            min    avg    max\n");
+    (void)intPrioSet(irq_num, 0xFFu);
+    (void)intEnable(irq_num);
+    intbench_run("stub", irq_num, 1u);
+    intbench_run("direct", irq_num, 0u);
+    (void)intDisable(irq_num);
+    (void)intDisconnect(irq_num);
+
+    return 0;
+}
+
+SHELL_CMD(intbench, 2, do_intbench, "intbench <unused irq>\r\n");
+
+#endif /* INCLUDE_INT_BENCH */
+/*-------------------------------intbench.c----------------------------------*/
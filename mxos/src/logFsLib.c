@@ -0,0 +1,489 @@
+/**
+ ******************************************************************************
+ * @file      logFsLib.c
+ * @brief     ʵ־浽FatFsļ.
+ * @details   logMsgÿ־СĴ仺, дһ(
+ *            ˢʱ)ͽLogFs; LogFsص
+ *            f_write, ʱf_sync, ļLOGFS_FILE_SIZEʱת:
+ *            LOG.TXT -> LOG1.TXT -> ... -> LOG(LOGFS_FILES-1).TXT.
+ *            仺þʱ, logMsg־.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <types.h>
+#include <maths.h>
+#include <taskLib.h>
+#include <dmnLib.h>
+#include <debug.h>
+#include <logLib.h>
+#include <logFsLib.h>
+#include <shell.h>
+#include <ff.h>
+#include <oscfg.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef LOGFS_SECTOR_SIZE
+# define LOGFS_SECTOR_SIZE        (_MAX_SS) /**< С */
+#endif
+
+#ifndef LOGFS_BUFS
+# define LOGFS_BUFS                 (4u)    /**< 仺 */
+#endif
+
+#ifndef LOGFS_FILE_SIZE
+# define LOGFS_FILE_SIZE   (256u * 1024u)   /**< ־ļС */
+#endif
+
+#ifndef LOGFS_FILES
+# define LOGFS_FILES                (4u)    /**< ־ļ(ǰ) */
+#endif
+
+#ifndef LOGFS_SYNC_SECONDS
+# define LOGFS_SYNC_SECONDS         (5u)    /**< f_sync */
+#endif
+
+#ifndef LOGFS_SYNC_SECTORS
+# define LOGFS_SYNC_SECTORS        (16u)    /**< дf_sync */
+#endif
+
+#ifndef TASK_PRIORITY_LOGFS
+# define TASK_PRIORITY_LOGFS        (1u)    /**< LogFsȼ */
+#endif
+
+#ifndef TASK_STK_SIZE_LOGFS
+# define TASK_STK_SIZE_LOGFS     (1024u)    /**< LogFsջ */
+#endif
+
+#define LOGFS_NAME_LEN             (24u)    /**< ļ󳤶 */
+
+#if (LOGFS_FILES > 10u)
+# error "Plesase set LOGFS_FILES <= (10u)"
+#endif
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** СĴ仺, 4ֽڶԱײֱDMA */
+typedef struct
+{
+    uint32_t len;                                   /**< ֽ */
+    uint32_t data[LOGFS_SECTOR_SIZE / 4u];          /**<  */
+} logfs_buf_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static TASK_ID the_logfs_taskid = NULL;
+static SEM_ID the_logfs_sem = NULL;
+static char_t the_logfs_base[LOGFS_NAME_LEN - 6u];  /**< ·, ".TXT" */
+
+/* 仺: logMsgдthe_fill_seq, LogFsдƽthe_done_seq */
+static logfs_buf_t the_logfs_bufs[LOGFS_BUFS];
+static volatile uint32_t the_fill_seq = 0u;
+static volatile uint32_t the_done_seq = 0u;
+
+/* ֻLogFsʹ */
+static FIL the_logfs_file;
+static bool_e the_logfs_opened = FALSE;
+static uint32_t the_sect[LOGFS_SECTOR_SIZE / 4u];   /**< ǰļ */
+static uint32_t the_sect_len = 0u;                  /**< ǰֽ */
+static uint32_t the_sect_saved = 0u;                /**< ǰдļֽ */
+static DWORD the_sect_pos = 0u;                     /**< ǰļƫ */
+static uint32_t the_unsynced = 0u;                  /**< ϴf_syncд */
+
+/* ͳ */
+static uint32_t the_logfs_lost = 0u;                /**< ֽ(taskLock) */
+static uint32_t the_logfs_written = 0u;             /**< д */
+static FRESULT the_logfs_err = FR_OK;               /**< һδ */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ɵn־ļ, 0Ϊǰļ
+ * @param[out] pname : ļ
+ * @param[in]  n     : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+logfs_name(char_t *pname, uint32_t n)
+{
+    if (n == 0u)
+    {
+        (void)snprintf(pname, LOGFS_NAME_LEN, "%s.TXT", the_logfs_base);
+    }
+    else
+    {
+        (void)snprintf(pname, LOGFS_NAME_LEN, "%s%u.TXT", the_logfs_base, n);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ۼƶֽ, logfs_sinktaskLock
+ * @param[in]  len : ֽ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+logfs_lost(uint32_t len)
+{
+    taskLock();
+    the_logfs_lost += len;
+    taskUnlock();
+}
+
+/**
+ ******************************************************************************
+ * @brief   򿪵ǰ־ļ, ĩβһԱ
+ * @param[in]  None
+ *
+ * @retval     OK   : ɹ
+ * @retval     ERROR: ʧ
+ ******************************************************************************
+ */
+static status_t
+logfs_open(void)
+{
+    char_t name[LOGFS_NAME_LEN];
+    UINT br = 0u;
+    FRESULT res;
+
+    logfs_name(name, 0u);
+    res = f_open(&the_logfs_file, name, FA_OPEN_ALWAYS | FA_READ | FA_WRITE);
+    if (res != FR_OK)
+    {
+        the_logfs_err = res;
+        return ERROR;
+    }
+
+    the_sect_pos = f_size(&the_logfs_file)
+            & ~(DWORD)(LOGFS_SECTOR_SIZE - 1u);
+    the_sect_len = f_size(&the_logfs_file) - the_sect_pos;
+    the_sect_saved = the_sect_len;
+    res = f_lseek(&the_logfs_file, the_sect_pos);
+    if ((res == FR_OK) && (the_sect_len != 0u))
+    {
+        res = f_read(&the_logfs_file, the_sect, the_sect_len, &br);
+        if (res == FR_OK)
+        {
+            res = f_lseek(&the_logfs_file, the_sect_pos);
+        }
+    }
+    if ((res != FR_OK) || (br != the_sect_len))
+    {
+        the_logfs_err = (res != FR_OK) ? res : FR_INT_ERR;
+        (void)f_close(&the_logfs_file);
+        return ERROR;
+    }
+
+    the_logfs_opened = TRUE;
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   رյǰļת: ɾļ, ż1
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+logfs_rotate(void)
+{
+    char_t from[LOGFS_NAME_LEN];
+    char_t to[LOGFS_NAME_LEN];
+    uint32_t n;
+
+    (void)f_close(&the_logfs_file);
+    the_logfs_opened = FALSE;
+    the_unsynced = 0u;
+
+    logfs_name(to, LOGFS_FILES - 1u);
+    (void)f_unlink(to);
+    for (n = LOGFS_FILES - 1u; n > 0u; n--)
+    {
+        logfs_name(from, n - 1u);
+        logfs_name(to, n);
+        (void)f_rename(from, to);
+    }
+    (void)logfs_open();
+}
+
+/**
+ ******************************************************************************
+ * @brief   дǰ. δʱΪʱˢ, дļָ˻,
+ *          дд
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+logfs_write_sect(void)
+{
+    UINT bw = 0u;
+    FRESULT res;
+
+    res = f_write(&the_logfs_file, the_sect, the_sect_len, &bw);
+    if ((res != FR_OK) || (bw != the_sect_len))
+    {
+        the_logfs_err = (res != FR_OK) ? res : FR_DENIED;  /*  */
+        (void)f_close(&the_logfs_file);
+        the_logfs_opened = FALSE;
+        /* ´ʱ汻ļĩβ, δдļĲּ붪 */
+        logfs_lost(the_sect_len - the_sect_saved);
+        the_sect_len = 0u;
+        return;
+    }
+
+    if (the_sect_len < LOGFS_SECTOR_SIZE)
+    {
+        the_sect_saved = the_sect_len;
+        (void)f_lseek(&the_logfs_file, the_sect_pos);
+        return;
+    }
+
+    the_logfs_written++;
+    the_unsynced++;
+    the_sect_pos += LOGFS_SECTOR_SIZE;
+    the_sect_len = 0u;
+    the_sect_saved = 0u;
+    if (the_sect_pos >= LOGFS_FILE_SIZE)
+    {
+        logfs_rotate();
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ݵǰ, д. ļѹر(дʧ)ʱ
+ *          ʣݼ붪
+ * @param[in]  pdata : 
+ * @param[in]  len   : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+logfs_put(const uint8_t *pdata, uint32_t len)
+{
+    uint32_t n;
+
+    while ((len != 0u) && (the_logfs_opened == TRUE))
+    {
+        n = MIN(len, LOGFS_SECTOR_SIZE - the_sect_len);
+        memcpy((uint8_t *)the_sect + the_sect_len, pdata, n);
+        the_sect_len += n;
+        pdata += n;
+        len -= n;
+        if (the_sect_len == LOGFS_SECTOR_SIZE)
+        {
+            logfs_write_sect();
+        }
+    }
+    if (len != 0u)
+    {
+        logfs_lost(len);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   LogFsִ
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+logfs_loop(void)
+{
+    logfs_buf_t *pbuf;
+    uint32_t last_sync = tickGet();
+    bool_e sync;
+    DMN_ID dmnid = dmn_register();
+    D_ASSERT(dmnid != NULL);
+
+    while (1)
+    {
+        dmn_sign(dmnid);
+        (void)semTake(the_logfs_sem, TICKS_PER_SECOND);
+
+        if ((the_logfs_opened == FALSE) && (logfs_open() != OK))
+        {
+            /* ļϵͳδ, Ļ, Ժ; the_logfs_lost
+               logfs_sinktaskLock */
+            taskLock();
+            while (the_done_seq != the_fill_seq)
+            {
+                pbuf = &the_logfs_bufs[the_done_seq % LOGFS_BUFS];
+                the_logfs_lost += pbuf->len;
+                pbuf->len = 0u;
+                the_done_seq++;
+            }
+            taskUnlock();
+            continue;
+        }
+
+        sync = (the_unsynced >= LOGFS_SYNC_SECTORS)
+                || ((tickGet() - last_sync)
+                        >= (LOGFS_SYNC_SECONDS * TICKS_PER_SECOND));
+        if (sync == TRUE)
+        {
+            /* ʱˢ: дĴ仺Ҳ */
+            taskLock();
+            pbuf = &the_logfs_bufs[the_fill_seq % LOGFS_BUFS];
+            if (((the_fill_seq - the_done_seq) < LOGFS_BUFS)
+                    && (pbuf->len != 0u))
+            {
+                the_fill_seq++;
+            }
+            taskUnlock();
+        }
+
+        /* дѽĴ仺, д㳤ȹ黹logfs_sink */
+        while (the_done_seq != the_fill_seq)
+        {
+            pbuf = &the_logfs_bufs[the_done_seq % LOGFS_BUFS];
+            logfs_put((const uint8_t *)pbuf->data, pbuf->len);
+            pbuf->len = 0u;
+            the_done_seq++;
+        }
+
+        if (sync == FALSE)
+        {
+            continue;
+        }
+        if ((the_logfs_opened == TRUE) && (the_sect_len != 0u))
+        {
+            logfs_write_sect();
+        }
+        if (the_logfs_opened == TRUE)
+        {
+            (void)f_sync(&the_logfs_file);
+        }
+        the_unsynced = 0u;
+        last_sync = tickGet();
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ־Ŀ: logMsgаһ־仺
+ * @param[in]  pstr : 
+ * @param[in]  len  : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+logfs_sink(const char_t *pstr, uint32_t len)
+{
+    logfs_buf_t *pbuf;
+    uint32_t n;
+
+    /* LogFsʱˢʱύδ廥, ٽֻڴ濽 */
+    taskLock();
+    while (len != 0u)
+    {
+        if ((the_fill_seq - the_done_seq) >= LOGFS_BUFS)
+        {
+            the_logfs_lost += len;  /* 仺ȫ, ȴ */
+            break;
+        }
+        pbuf = &the_logfs_bufs[the_fill_seq % LOGFS_BUFS];
+        n = MIN(len, LOGFS_SECTOR_SIZE - pbuf->len);
+        memcpy((uint8_t *)pbuf->data + pbuf->len, pstr, n);
+        pbuf->len += n;
+        pstr += n;
+        len -= n;
+        if (pbuf->len == LOGFS_SECTOR_SIZE)
+        {
+            the_fill_seq++;     /* LogFs, дlen */
+            (void)semGive(the_logfs_sem);
+        }
+    }
+    taskUnlock();
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʼ־ļ, ļϵͳغ
+ * @param[in]  pbase     : ļ·(չ), "0:/LOG"
+ * @param[in]  stacksize : ջС, 0ʹĬֵ
+ *
+ * @retval  OK      : ʼɹ
+ * @retval  ERROR   : ʼʧ
+ ******************************************************************************
+ */
+status_t
+logfs_init(const char_t *pbase, uint32_t stacksize)
+{
+    if (the_logfs_taskid != NULL)
+    {
+        return OK; /* already called */
+    }
+    if ((pbase == NULL) || (strlen(pbase) >= sizeof(the_logfs_base)))
+    {
+        return ERROR;
+    }
+    strcpy(the_logfs_base, pbase);
+
+    stacksize = (stacksize == 0) ? TASK_STK_SIZE_LOGFS : stacksize;
+    the_logfs_sem = semBCreate(0);
+    D_ASSERT(the_logfs_sem != NULL);
+
+    the_logfs_taskid = taskSpawn((const signed char * const ) "LogFs",
+            TASK_PRIORITY_LOGFS, stacksize, (OSFUNCPTR) logfs_loop, 0);
+    D_ASSERT(the_logfs_taskid != NULL);
+
+    return loglib_sink_add(logfs_sink);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ־ļ״̬
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+logfs_show_info(void)
+{
+    printf("  LOG FILE INFOMATION\n");
+    printf("file:%s.TXT  opened:%d  size:%u\n", the_logfs_base,
+            the_logfs_opened,
+            (the_logfs_opened == TRUE) ?
+                    (uint32_t)(the_sect_pos + the_sect_len) : 0u);
+    printf("sectors written:%u  bytes lost:%u  last error:%d\n",
+            the_logfs_written, the_logfs_lost, the_logfs_err);
+    printf("\n");
+}
+
+/*SHELL CMD FOR LOGFS*/
+uint32_t
+do_logfs(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    logfs_show_info();
+    return 0;
+}
+
+SHELL_CMD(logfs, 1, do_logfs, "logfs -- show log file state\r\n");
+
+/*--------------------------------logFsLib.c---------------------------------*/
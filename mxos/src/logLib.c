@@ -15,14 +15,20 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <stdarg.h>
+#include <time.h>
 #include <types.h>
 #include <maths.h>
 #include <taskLib.h>
 #include <debug.h>
 #include <intLib.h>
 #include <dmnLib.h>
+#include <oshook.h>
+#include <logLib.h>
+#include <osLib.h>
+#include <clkLib.h>
+#include <shell.h>
 #include <oscfg.h>
+#include <FreeRTOS.h>
 
 #ifndef INCLUDE_LOGMSG_SUPPORT
 # define INCLUDE_LOGMSG_SUPPORT (0u)
@@ -33,7 +39,7 @@
  Section: Macro Definitions
  ----------------------------------------------------------------------------*/
 #ifndef MAX_MSGS
-# define MAX_MSGS                  (10u)    /**< ϢеϢ */
+# define MAX_MSGS                  (16u)    /**< ԤϢ(2) */
 #endif
 
 #ifndef MAX_BYTES_IN_A_MSG
@@ -48,38 +54,430 @@
 # define TASK_STK_SIZE_LOGMSG     (1024u)    /**< logMsgĶջС */
 #endif
 
+#ifndef LOG_DEFER_RECS
+# define LOG_DEFER_RECS            (64u)    /**< ӳٸʽ¼(2) */
+#endif
+
+#ifndef LOG_IDLE_TICKS
+# define LOG_IDLE_TICKS (30u * TICKS_PER_SECOND) /**< ־ʱĵȴʱ(ι) */
+#endif
+
+#ifndef LOG_BATCH_SIZE
+# define LOG_BATCH_SIZE           (256u)    /**< logMsgС */
+#endif
+
+#ifndef LOG_MAX_SINKS
+# define LOG_MAX_SINKS              (2u)    /**< ̨־Ŀ */
+#endif
+
+#define LOG_US_PER_SEC      (1000000)
+#define LOG_NAME_LEN        (configMAX_TASK_NAME_LEN)   /**< ¼е */
+
+#define LOG_MSG_MASK        (MAX_MSGS - 1u)
+C_ASSERT((MAX_MSGS & LOG_MSG_MASK) != 0u);
+
+#define LOG_DEFER_MASK      (LOG_DEFER_RECS - 1u)
+C_ASSERT((LOG_DEFER_RECS & LOG_DEFER_MASK) != 0u);
+
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-#pragma pack(push, 1)
-
-/** log msg ṹ嶨 */
+/** ʽ־Ϣ, Ԥڻλ */
 typedef struct
 {
-    int32_t id;     /**< ID of sending task */
-    int32_t len;    /**< len of logmsg buf */
-    uint8_t buf[MAX_BYTES_IN_A_MSG]; /**< format logmsg buf */
+    volatile uint32_t ready;    /**< 1: Ϣд, ɱlogMsgȡ */
+    uint32_t stamp;             /**< ¼ʱ(us, bsp_timer_get) */
+    char_t name[LOG_NAME_LEN];  /**< ¼ʱ, жΪմ */
+    int32_t len;                /**< len of logmsg buf */
+    char_t buf[MAX_BYTES_IN_A_MSG]; /**< format logmsg buf */
 } log_msg_t;
 
-#pragma pack(pop)
+/** ӳٸʽ¼: ôֻʽָͲԭʼ, logMsgʽ */
+typedef struct
+{
+    volatile uint32_t ready;        /**< 1: ¼д, ɱlogMsgȡ */
+    const char *fmt;                /**< ʽ(Ϊ) */
+    uint32_t stamp;                 /**< ¼ʱ(us, bsp_timer_get) */
+    char_t name[LOG_NAME_LEN];      /**< ¼ʱ, жΪմ */
+    uint32_t args[LOG_DEFER_MAX_ARGS]; /**< ԭʼ */
+} log_defer_t;
 
 /*-----------------------------------------------------------------------------
  Section: Globals Function
  ----------------------------------------------------------------------------*/
-extern int print(char **out, const char *format, va_list args );
 extern void printstr(const char *pStr, int len);
 
 /*-----------------------------------------------------------------------------
  Section: Local Variables
  ----------------------------------------------------------------------------*/
+static const char_t the_hex_digits[] = "0123456789abcdef";
+
 static TASK_ID the_logmsg_taskid = NULL;
-static MSG_Q_ID the_logmsg_qid = NULL;
+static SEM_ID the_logmsg_sem = NULL;    /**< дϢlogMsg */
 static int32_t the_logmsgs_lost = 0;
 static int32_t the_logmsgs_outoflen = 0;
 
+static log_msg_t the_msg_ring[MAX_MSGS];
+static volatile uint32_t the_msg_wr = 0u;      /**< Ԥд */
+static volatile uint32_t the_msg_rd = 0u;      /**< logMsgĶ */
+
+static log_defer_t the_defer_ring[LOG_DEFER_RECS];
+static volatile uint32_t the_defer_wr = 0u;    /**< Ԥд */
+static volatile uint32_t the_defer_rd = 0u;    /**< logMsgĶ */
+
+static char_t the_log_batch[LOG_BATCH_SIZE];   /**<  */
+static uint32_t the_log_batch_len = 0u;
+
+static log_sink_t the_log_sinks[LOG_MAX_SINKS];  /**< ־洢/תĿ */
+static bool_e the_log_bol = TRUE;              /**< һֽλ */
+
+/* ʱ, ֻlogMsgʹ */
+static uint32_t the_time_raw = 0u;      /**< ׼ʱ̵bsp_timer_getֵ */
+static time_t the_time_sec = 0;         /**< ׼ʱ̵ʱ() */
+static int32_t the_time_us = 0;         /**< ׼ʱ̵΢ */
+static tm_cache_t the_time_cache = { .sec = (time_t)-1 };
+static time_t the_prefix_sec = (time_t)-1;  /**< the_prefix_dateӦ */
+static char_t the_prefix_date[24];      /**< "[YYYY-MM-DD hh:mm:ss." */
+static uint32_t the_prefix_date_len = 0u;
+
 /*-----------------------------------------------------------------------------
  Section: Function Prototypes
  ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   Ԥλеһλ, O(1), же
+ * @param[in]  pwr   : д
+ * @param[in]  rd    : 
+ * @param[in]  depth : λ
+ * @param[out] pseq  : Ԥ
+ *
+ * @retval     TRUE  : Ԥɹ
+ * @retval     FALSE : , the_logmsgs_lost
+ ******************************************************************************
+ */
+static bool_e
+loglib_reserve(volatile uint32_t *pwr, uint32_t rd, uint32_t depth,
+        uint32_t *pseq)
+{
+    uint32_t wr;
+
+    do
+    {
+        wr = *pwr;
+        if ((wr - rd) >= depth)
+        {
+            (void)__sync_fetch_and_add(&the_logmsgs_lost, 1);
+            return FALSE;
+        }
+    } while (!__sync_bool_compare_and_swap(pwr, wr, wr + 1u));
+
+    *pseq = wr;
+    return TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   дλ󷢲logMsg, же
+ * @param[in]  pready : λready־
+ * @param[in]  seq    : λ
+ * @param[in]  prd    : λĶ
+ *
+ * @retval     None
+ *
+ * @details ֻлɿձΪǿ(ŵڱλ)ʱŻlogMsg;
+ *          logMsgδȡλ, ȡǰļ¼ȡ.
+ ******************************************************************************
+ */
+static void
+loglib_commit(volatile uint32_t *pready, uint32_t seq,
+        const volatile uint32_t *prd)
+{
+    __sync_synchronize();
+    *pready = 1u;
+    __sync_synchronize();
+
+    if (*prd == seq)
+    {
+        (void)semGive(the_logmsg_sem);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ¼ʱǰ, ʱѱɾ
+ * @param[out] pname : (LOG_NAME_LENֽ), жΪմ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+loglib_capture_name(char_t *pname)
+{
+    const char_t *ptask = NULL;
+
+    if (intContext() == FALSE)
+    {
+        ptask = taskName(taskIdSelf());
+    }
+    if (ptask == NULL)
+    {
+        pname[0] = '\0';
+        return;
+    }
+    (void)strncpy(pname, ptask, LOG_NAME_LEN - 1u);
+    pname[LOG_NAME_LEN - 1u] = '\0';
+}
+
+/**
+ ******************************************************************************
+ * @brief   һ־̨עĿ
+ * @param[in]  pstr : 
+ * @param[in]  len  : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+loglib_write(const char_t *pstr, uint32_t len)
+{
+    uint32_t i;
+
+    printstr(pstr, len);
+    for (i = 0u; i < LOG_MAX_SINKS; i++)
+    {
+        if (the_log_sinks[i] != NULL)
+        {
+            the_log_sinks[i](pstr, len);
+        }
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ׷ݵ, ʱ
+ * @param[in]  pstr : 
+ * @param[in]  len  : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+loglib_emit(const char_t *pstr, uint32_t len)
+{
+    uint32_t n;
+
+    if (len != 0u)
+    {
+        the_log_bol = (pstr[len - 1u] == '\n') ? TRUE : FALSE;
+    }
+    while (len != 0u)
+    {
+        n = MIN(len, LOG_BATCH_SIZE - the_log_batch_len);
+        memcpy(&the_log_batch[the_log_batch_len], pstr, n);
+        the_log_batch_len += n;
+        pstr += n;
+        len -= n;
+        if (the_log_batch_len == LOG_BATCH_SIZE)
+        {
+            loglib_write(the_log_batch, the_log_batch_len);
+            the_log_batch_len = 0u;
+        }
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʣ
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+loglib_flush(void)
+{
+    if (the_log_batch_len != 0u)
+    {
+        loglib_write(the_log_batch, the_log_batch_len);
+        the_log_batch_len = 0u;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʱ׼, ÿδ־ǰ
+ * @param[in]  None
+ *
+ * @retval     None
+ *
+ * @details ׼bsp_timer_getǰ, ֤¼ʱ׼֮ԶСڼ
+ *          ; ϵͳʱ1(Уʱ)ʱ¶.
+ ******************************************************************************
+ */
+static void
+loglib_time_sync(void)
+{
+    struct timespec tp;
+    uint32_t now = bsp_timer_get();
+    uint32_t elapsed = now - the_time_raw;
+    int32_t diff;
+
+    the_time_raw = now;
+    the_time_sec += (time_t)(elapsed / LOG_US_PER_SEC);
+    the_time_us += (int32_t)(elapsed % LOG_US_PER_SEC);
+    if (the_time_us >= LOG_US_PER_SEC)
+    {
+        the_time_us -= LOG_US_PER_SEC;
+        the_time_sec++;
+    }
+
+    if (clock_gettime(CLOCK_REALTIME, &tp) == OK)
+    {
+        diff = (int32_t)(tp.tv_sec - the_time_sec);
+        if ((diff > 1) || (diff < -1))
+        {
+            the_time_sec = tp.tv_sec;
+            the_time_us = tp.tv_nsec / 1000;
+        }
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   һ־ǰ׺"[YYYY-MM-DD hh:mm:ss.uuuuuu] : "
+ * @param[in]  pname : ¼ʱ, մΪж
+ * @param[in]  stamp : ¼ʱ(us, bsp_timer_get)
+ *
+ * @retval     None
+ *
+ * @details ڲְ뻺, ͬһڵļ¼ֻʽ΢.
+ ******************************************************************************
+ */
+static void
+loglib_emit_prefix(const char_t *pname, uint32_t stamp)
+{
+    struct tm daytime;
+    char_t us[8];
+    int32_t delta = (int32_t)(stamp - the_time_raw);
+    time_t sec = the_time_sec + (time_t)(delta / LOG_US_PER_SEC);
+    int32_t usec = the_time_us + (delta % LOG_US_PER_SEC);
+    int32_t i;
+
+    if (the_log_bol == FALSE)
+    {
+        return; /* дһδе־ */
+    }
+
+    if (usec < 0)
+    {
+        usec += LOG_US_PER_SEC;
+        sec--;
+    }
+    else if (usec >= LOG_US_PER_SEC)
+    {
+        usec -= LOG_US_PER_SEC;
+        sec++;
+    }
+
+    if (sec != the_prefix_sec)
+    {
+        localtime_cached(&the_time_cache, sec, &daytime);
+        the_prefix_date_len = (uint32_t)snprintf(the_prefix_date,
+                sizeof(the_prefix_date), "[%04d-%02d-%02d %02d:%02d:%02d.",
+                daytime.tm_year + 1900, daytime.tm_mon + 1, daytime.tm_mday,
+                daytime.tm_hour, daytime.tm_min, daytime.tm_sec);
+        the_prefix_sec = sec;
+    }
+    loglib_emit(the_prefix_date, the_prefix_date_len);
+
+    for (i = 5; i >= 0; i--)
+    {
+        us[i] = (char_t)('0' + (usec % 10));
+        usec /= 10;
+    }
+    us[6] = ']';
+    us[7] = ' ';
+    loglib_emit(us, sizeof(us));
+
+    if (pname[0] == '\0')
+    {
+        pname = "interrupt";
+    }
+    loglib_emit(pname, strlen(pname));
+    loglib_emit(": ", 2u);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʽдӳټ¼
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+loglib_drain_defer(void)
+{
+    char_t buf[MAX_BYTES_IN_A_MSG];
+    log_defer_t *prec;
+    int32_t len;
+
+    while (the_defer_rd != the_defer_wr)
+    {
+        prec = &the_defer_ring[the_defer_rd & LOG_DEFER_MASK];
+        if (prec->ready == 0u)
+        {
+            break;  /* δд, ´ȡ */
+        }
+
+        loglib_emit_prefix(prec->name, prec->stamp);
+        /* Ϊ32λ, ഫĲᱻ */
+        len = snprintf(buf, sizeof(buf), prec->fmt,
+                prec->args[0], prec->args[1], prec->args[2],
+                prec->args[3], prec->args[4], prec->args[5]);
+        if (len > (int32_t)(sizeof(buf) - 1))
+        {
+            the_logmsgs_outoflen++;
+            len = sizeof(buf) - 1;
+        }
+        loglib_emit(buf, len);
+
+        prec->ready = 0u;
+        __sync_synchronize();
+        the_defer_rd++;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   дϢ
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+loglib_drain_msgs(void)
+{
+    log_msg_t *pmsg;
+
+    while (the_msg_rd != the_msg_wr)
+    {
+        pmsg = &the_msg_ring[the_msg_rd & LOG_MSG_MASK];
+        if (pmsg->ready == 0u)
+        {
+            break;  /* δд, ´ȡ */
+        }
+
+        loglib_emit_prefix(pmsg->name, pmsg->stamp);
+        loglib_emit(pmsg->buf, pmsg->len);
+
+        pmsg->ready = 0u;
+        __sync_synchronize();
+        the_msg_rd++;
+    }
+}
+
 /**
  ******************************************************************************
  * @brief   logMsg ִ
@@ -94,36 +492,28 @@ loglib_loop(void)
 {
     int32_t new_msgs_lost = 0;
     int32_t new_outoflen = 0;
-    log_msg_t *pmsg;
+    struct timespec tp;
     DMN_ID dmnid = dmn_register();
     D_ASSERT(dmnid != NULL);
 
+    the_time_raw = bsp_timer_get();
+    if (clock_gettime(CLOCK_REALTIME, &tp) == OK)
+    {
+        the_time_sec = tp.tv_sec;
+        the_time_us = tp.tv_nsec / 1000;
+    }
+
     while(1)
     {
         dmn_sign(dmnid);
-        if (OK == msgQReceive(the_logmsg_qid, 30 * TICKS_PER_SECOND, (void **) &pmsg))
-        {
-            /* print task ID */
-            if (pmsg->id == -1)
-            {
-                printf("interrupt: ");
-            }
-            else
-            {
-                //printf("%#x (%s): ", msg->id, checkName);
-            }
-
-            printstr((const char *)pmsg->buf, pmsg->len);
-#if 0
-            /* ùӺϢݴ洢 */
-            if (_func_logSaveHook != NULL)
-            {
-                (*_func_logSaveHook)(pmsg->buf, pmsg->len);
-            }
-#endif
+        /* loglib_commit, ʱֻΪι */
+        (void)semTake(the_logmsg_sem, LOG_IDLE_TICKS);
+        loglib_time_sync();
 
-            free(pmsg);
-        }
+        /* һλȡϢ, ϲΪٵĿ̨д */
+        loglib_drain_defer();
+        loglib_drain_msgs();
+        loglib_flush();
 
         /* check for any more messages lost */
         if (new_msgs_lost != the_logmsgs_lost)
@@ -137,6 +527,7 @@ loglib_loop(void)
         {
             printf("loglib: %d out of buf length.\n",
                     the_logmsgs_outoflen - new_outoflen);
+            new_outoflen = the_logmsgs_outoflen;
         }
 
     }
@@ -160,9 +551,9 @@ loglib_init(uint32_t stacksize)
     }
 
     stacksize = (stacksize == 0) ? TASK_STK_SIZE_LOGMSG : stacksize;
-    the_logmsg_qid = msgQCreate(MAX_MSGS);
+    the_logmsg_sem = semBCreate(0);
 
-    D_ASSERT(the_logmsg_qid != NULL);
+    D_ASSERT(the_logmsg_sem != NULL);
 
     the_logmsg_taskid = taskSpawn((const signed char * const ) "LogMsg",
             TASK_PRIORITY_LOGMSG, stacksize, (OSFUNCPTR) loglib_loop, 0);
@@ -171,62 +562,135 @@ loglib_init(uint32_t stacksize)
     return (OK);
 }
 
+/**
+ ******************************************************************************
+ * @brief   ע־Ŀ(ļ)
+ * @param[in]  sink : , logMsgΪλ, 
+ *
+ * @retval  OK      : עɹ
+ * @retval  ERROR   : Ŀ
+ ******************************************************************************
+ */
+status_t
+loglib_sink_add(log_sink_t sink)
+{
+    uint32_t i;
+
+    for (i = 0u; i < LOG_MAX_SINKS; i++)
+    {
+        if ((the_log_sinks[i] == NULL) || (the_log_sinks[i] == sink))
+        {
+            the_log_sinks[i] = sink;
+            return OK;
+        }
+    }
+    return ERROR;
+}
+
 /**
  ******************************************************************************
  * @brief   ־
  * @param[in]  fmt  : ־Ϣprintfͬ
  *
- * @retval     ERROR: ־Ϣʧ
+ * @retval     ERROR: Ϣ, ־
  * @retval     OK   : ־Ϣɹ
  ******************************************************************************
  */
 status_t
 logmsg(const char *fmt, ...)
 {
-    log_msg_t *msg;
+    log_msg_t *pmsg;
+    uint32_t seq;
+    int32_t len;
+    va_list args;
 
     if (the_logmsg_taskid == NULL)
     {
-        va_list args;
-
         va_start( args, fmt );
-        print( 0, fmt, args );
+        vprintf( fmt, args );
+        va_end(args);
         return OK;
     }
 
-    if (strlen(fmt) > (MAX_BYTES_IN_A_MSG - 1))
+    if (loglib_reserve(&the_msg_wr, the_msg_rd, MAX_MSGS, &seq) == FALSE)
     {
         return ERROR;
     }
-    msg = malloc(sizeof(log_msg_t));
+    pmsg = &the_msg_ring[seq & LOG_MSG_MASK];
 
     /* жǷже */
-    msg->id = (intContext() == TRUE) ? -1 : (int32_t)taskIdSelf();
-
-    char *out = (char *)msg->buf;
+    pmsg->stamp = bsp_timer_get();
+    loglib_capture_name(pmsg->name);
 
-    va_list args;
     va_start( args, fmt );
-    msg->len = print( &out, fmt, args );
+    len = vsnprintf(pmsg->buf, sizeof(pmsg->buf), fmt, args);
     va_end(args);
 
-    if (msg->len > (MAX_BYTES_IN_A_MSG - 1))
+    if (len > (int32_t)(MAX_BYTES_IN_A_MSG - 1))
     {
-        the_logmsgs_outoflen++; /* shit out of buf length */
+        the_logmsgs_outoflen++; /* ѱض */
+        len = MAX_BYTES_IN_A_MSG - 1;
     }
-    msg->buf[msg->len] = '\0';
+    pmsg->len = len;
 
+    loglib_commit(&pmsg->ready, seq, &the_msg_rd);
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ӳٸʽ־, же
+ * @param[in]  fmt   : ʽ, Ϊַ
+ * @param[in]  nargs : (LOG_DEFER_MAX_ARGS)
+ * @param[in]  ...   : , ÿ32λָ
+ *
+ * @retval     ERROR: ¼, ־
+ * @retval     OK   : ¼ɹ
+ *
+ * @details ֻʽָ롢ʱIDͲԭʼ, ʽҲ
+ *          ڴ, ʽlogMsg. %sַָ
+ *          ǰ뱣Ч, Ҳ֧%f%ll. һͨLOGD().
+ ******************************************************************************
+ */
+status_t
+logdefer(const char *fmt, uint32_t nargs, ...)
+{
+    log_defer_t *prec;
+    uint32_t seq;
+    uint32_t i;
+    va_list args;
 
-    if (msgQSend(the_logmsg_qid, (void *) msg) != OK)
+    if (the_logmsg_taskid == NULL)
+    {
+        va_start(args, nargs);
+        vprintf(fmt, args);
+        va_end(args);
+        return OK;
+    }
+
+    /* Ԥһ¼, ɱȼжϴ */
+    if (loglib_reserve(&the_defer_wr, the_defer_rd, LOG_DEFER_RECS, &seq)
+            == FALSE)
     {
-        ++the_logmsgs_lost;
         return ERROR;
     }
+    prec = &the_defer_ring[seq & LOG_DEFER_MASK];
+    prec->fmt = fmt;
+    prec->stamp = bsp_timer_get();
+    loglib_capture_name(prec->name);
+
+    va_start(args, nargs);
+    for (i = 0u; i < LOG_DEFER_MAX_ARGS; i++)
+    {
+        prec->args[i] = (i < nargs) ? va_arg(args, uint32_t) : 0u;
+    }
+    va_end(args);
+
+    loglib_commit(&prec->ready, seq, &the_defer_rd);
 
     return OK;
 }
 
-
 /**
  ******************************************************************************
  * @brief   loglibָĻ
@@ -240,7 +704,10 @@ logmsg(const char *fmt, ...)
 status_t
 logbuf(const uint8_t *pbuf, uint32_t len)
 {
-    log_msg_t *msg;
+    log_msg_t *pmsg;
+    uint32_t seq;
+    uint32_t i;
+    uint32_t n;
 
     if (the_logmsg_taskid == NULL)
     {
@@ -248,42 +715,38 @@ logbuf(const uint8_t *pbuf, uint32_t len)
         return OK;
     }
 
-    msg = malloc(sizeof(log_msg_t));
+    if (loglib_reserve(&the_msg_wr, the_msg_rd, MAX_MSGS, &seq) == FALSE)
+    {
+        return ERROR;
+    }
+    pmsg = &the_msg_ring[seq & LOG_MSG_MASK];
 
     /* жǷже */
-    msg->id = (intContext() == TRUE) ? -1 : (int32_t)taskIdSelf();
+    pmsg->stamp = bsp_timer_get();
+    loglib_capture_name(pmsg->name);
 
-    int32_t i;
-    for (i = 0; i < MIN(len , ((MAX_BYTES_IN_A_MSG - 2) / 3)); i++)
+    /* ÿֽ"xx ", "\r\n" */
+    n = MIN(len, ((MAX_BYTES_IN_A_MSG - 2) / 3));
+    for (i = 0; i < n; i++)
     {
-        (void)sprintf((char *)msg->buf + (i*3) , "%02x ", *pbuf);
-        msg->len += 3;
-        pbuf++;
+        pmsg->buf[i * 3] = the_hex_digits[pbuf[i] >> 4];
+        pmsg->buf[(i * 3) + 1] = the_hex_digits[pbuf[i] & 0x0f];
+        pmsg->buf[(i * 3) + 2] = ' ';
     }
-    msg->buf[i*3] = '\r';
-    msg->buf[(i*3)+1] = '\n';
-    msg->len += 2;
-    if (msg->len > (MAX_BYTES_IN_A_MSG - 1))
-    {
-        the_logmsgs_outoflen++; /* shit out of buf length */
-    }
-    msg->buf[msg->len] = '\0';
-
-
-    if (msgQSend(the_logmsg_qid, (void *) msg) != OK)
+    pmsg->buf[n * 3] = '\r';
+    pmsg->buf[(n * 3) + 1] = '\n';
+    pmsg->len = (n * 3) + 2;
+    if (n < len)
     {
-        ++the_logmsgs_lost;
-        return ERROR;
+        the_logmsgs_outoflen++; /* δ */
     }
 
+    loglib_commit(&pmsg->ready, seq, &the_msg_rd);
     return OK;
-
 }
 
 #else
 
-extern int print(char **out, const char *format, va_list args );
-extern void printbuffer(char_t* format, const uint8_t* buffer, int32_t len);
 /**
  ******************************************************************************
  * @brief   logmsg ʼ
@@ -315,7 +778,43 @@ logmsg(const char *fmt, ...)
     va_list args;
 
     va_start( args, fmt );
-    print( 0, fmt, args );
+    vprintf( fmt, args );
+    va_end(args);
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ע־Ŀ(δlogMsgʱ֧)
+ * @param[in]  sink : 
+ *
+ * @retval  ERROR
+ ******************************************************************************
+ */
+status_t
+loglib_sink_add(log_sink_t sink)
+{
+    (void)sink;
+    return ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ӳٸʽ־(δlogMsgʱֱ)
+ * @param[in]  fmt   : ʽ
+ * @param[in]  nargs : 
+ *
+ * @retval     OK
+ ******************************************************************************
+ */
+status_t
+logdefer(const char *fmt, uint32_t nargs, ...)
+{
+    va_list args;
+
+    va_start(args, nargs);
+    vprintf(fmt, args);
+    va_end(args);
     return OK;
 }
 
@@ -337,4 +836,134 @@ logbuf(const uint8_t *pbuf, uint32_t len)
 }
 
 #endif
+
+/*-----------------------------------------------------------------------------
+ Section: Log Level
+ ----------------------------------------------------------------------------*/
+#ifndef LOG_DEFAULT_LEVEL
+# define LOG_DEFAULT_LEVEL  LOG_LVL_INFO    /**< ģĬм */
+#endif
+
+/** ģм, LOG_PRINT()ôֱӱȽ */
+uint8_t _the_log_levels[LOG_MOD_MAX] =
+{
+    [0 ... (LOG_MOD_MAX - 1)] = LOG_DEFAULT_LEVEL
+};
+
+/** ģ, log_module_eһһӦ */
+static const char_t * const the_log_mod_names[LOG_MOD_MAX] =
+{
+    "os", "mem", "dev", "net", "fs", "shell", "app"
+};
+
+/** , ±Ϊ */
+static const char_t * const the_log_lvl_names[] =
+{
+    "none", "error", "warn", "info", "debug"
+};
+
+/**
+ ******************************************************************************
+ * @brief   ģ־
+ * @param[in]  mod   : ģ(log_module_e), -1ʾģ
+ * @param[in]  level : LOG_LVL_XXX
+ *
+ * @retval     OK   : óɹ
+ * @retval     ERROR: 
+ ******************************************************************************
+ */
+status_t
+loglib_level_set(int32_t mod, uint8_t level)
+{
+    int32_t i;
+
+    if ((level > LOG_LVL_DEBUG) || (mod >= (int32_t)LOG_MOD_MAX) || (mod < -1))
+    {
+        return ERROR;
+    }
+    for (i = 0; i < (int32_t)LOG_MOD_MAX; i++)
+    {
+        if ((mod == -1) || (mod == i))
+        {
+            _the_log_levels[i] = level;
+        }
+    }
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ֲ, Ҳ-1
+ ******************************************************************************
+ */
+static int32_t
+loglib_name_find(const char_t * const *ptbl, int32_t num, const char_t *pname)
+{
+    int32_t i;
+
+    for (i = 0; i < num; i++)
+    {
+        if (strcmp(ptbl[i], pname) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ ******************************************************************************
+ * @brief   loglevel: 鿴ģ־
+ * @param[in]  argv[1] : ģall
+ * @param[in]  argv[2] : 0~4
+ *
+ * @retval     0 : ɹ
+ * @retval     1 : 
+ ******************************************************************************
+ */
+uint32_t
+do_loglevel(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    int32_t mod;
+    int32_t level;
+    int32_t i;
+
+    (void)cmdtp;
+    if (argc == 3u)
+    {
+        mod = (strcmp((const char_t *)argv[1], "all") == 0) ? -1 :
+            loglib_name_find(the_log_mod_names, LOG_MOD_MAX,
+                    (const char_t *)argv[1]);
+        level = loglib_name_find(the_log_lvl_names,
+                ARRAY_SIZE(the_log_lvl_names), (const char_t *)argv[2]);
+        if ((level < 0) && (argv[2][0] >= '0') && (argv[2][0] <= '9'))
+        {
+            level = argv[2][0] - '0';
+        }
+        if (((mod == -1) && (strcmp((const char_t *)argv[1], "all") != 0))
+                || (level < 0)
+                || (loglib_level_set(mod, (uint8_t)level) != OK))
+        {
+            printf("usage: loglevel [module|all level]\n");
+            return 1;
+        }
+    }
+    else if (argc != 1u)
+    {
+        printf("usage: loglevel [module|all level]\n");
+        return 1;
+    }
+
+    printf("compile level: %s\n", the_log_lvl_names[LOG_COMPILE_LEVEL]);
+    for (i = 0; i < (int32_t)LOG_MOD_MAX; i++)
+    {
+        printf("  %-8s %s\n", the_log_mod_names[i],
+                the_log_lvl_names[_the_log_levels[i]]);
+    }
+    return 0;
+}
+
+SHELL_CMD(loglevel, 3, do_loglevel,
+        "loglevel [module|all level] -- show/set log level\r\n");
+
 /*---------------------------------logLib.c----------------------------------*/
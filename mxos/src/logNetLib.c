@@ -0,0 +1,357 @@
+/**
+ ******************************************************************************
+ * @file      logNetLib.c
+ * @brief     ʵ־ͨUDP͵syslog.
+ * @details   logMsgÿ־мRFC5424ͷ:
+ *            "<134>1 - HOST mxos - - - ־", ƴһUDPķ
+ *            ̬Ļ, ͨtcpip_trycallbacktcpip̵߳udp_sendto.
+ *            Ļæƻtcpipʱ, .
+ *            Ͽ"nc -ul 514"ղ.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <types.h>
+#include <maths.h>
+#include <taskLib.h>
+#include <debug.h>
+#include <logLib.h>
+#include <logNetLib.h>
+#include <shell.h>
+#include <lwip/udp.h>
+#include <lwip/pbuf.h>
+#include <lwip/tcpip.h>
+#include <oscfg.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef LOGNET_DGRAM_SIZE
+# define LOGNET_DGRAM_SIZE        (512u)    /**< UDP󳤶 */
+#endif
+
+#ifndef LOGNET_BUFS
+# define LOGNET_BUFS                (2u)    /**< Ļ */
+#endif
+
+#ifndef LOGNET_RATE
+# define LOGNET_RATE               (20u)    /**< ÿ෢͵ı */
+#endif
+
+#define LOGNET_LINE_SIZE          (160u)    /**< ־󳤶 */
+#define LOGNET_HDR_SIZE            (48u)    /**< RFC5424ͷ󳤶 */
+#define LOGNET_PRI                 (134u)   /**< facility local0, severity info */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** Ļ, ʱtcpip̳߳ */
+typedef struct
+{
+    volatile bool_e busy;               /**< TRUE: ѽtcpip߳ */
+    uint16_t len;                       /**< ĳ */
+    uint16_t lines;                     /**< е־ */
+    struct tcpip_callback_msg *pmsg;    /**< ԤtcpipصϢ */
+    char_t data[LOGNET_DGRAM_SIZE];     /**<  */
+} lognet_buf_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static lognet_buf_t the_lognet_bufs[LOGNET_BUFS];
+static uint32_t the_lognet_cur = 0u;            /**< дıĻ */
+
+static char_t the_lognet_hdr[LOGNET_HDR_SIZE];  /**< ԤɵRFC5424ͷ */
+static uint32_t the_lognet_hdr_len = 0u;
+static char_t the_lognet_line[LOGNET_LINE_SIZE];/**< εδ */
+static uint32_t the_lognet_line_len = 0u;
+
+static struct udp_pcb *the_lognet_pcb = NULL;   /**< ֻtcpip߳ʹ */
+static ip_addr_t the_lognet_server;
+static uint16_t the_lognet_port = 514u;
+
+static uint32_t the_lognet_tokens = LOGNET_RATE;/**<  */
+static uint32_t the_lognet_last_tick = 0u;
+
+/* ͳ */
+static volatile uint32_t the_lognet_sent = 0u;  /**< ͳɹı */
+static volatile uint32_t the_lognet_lost = 0u;  /**< ־ */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   tcpip߳зһĻ
+ * @param[in]  ctx : Ļ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+lognet_send_cb(void *ctx)
+{
+    lognet_buf_t *pbuf = (lognet_buf_t *)ctx;
+    struct pbuf *p;
+
+    if (the_lognet_pcb == NULL)
+    {
+        the_lognet_pcb = udp_new();
+    }
+
+    /* PBUF_REFֱþ̬, ҪŶʱlwIPп */
+    p = pbuf_alloc(PBUF_TRANSPORT, pbuf->len, PBUF_REF);
+    if ((p != NULL) && (the_lognet_pcb != NULL))
+    {
+        p->payload = pbuf->data;
+        if (udp_sendto(the_lognet_pcb, p, &the_lognet_server,
+                the_lognet_port) == ERR_OK)
+        {
+            the_lognet_sent++;
+        }
+        else
+        {
+            (void)__sync_fetch_and_add(&the_lognet_lost, pbuf->lines);
+        }
+    }
+    else
+    {
+        (void)__sync_fetch_and_add(&the_lognet_lost, pbuf->lines);
+    }
+    if (p != NULL)
+    {
+        (void)pbuf_free(p);
+    }
+
+    pbuf->len = 0u;
+    pbuf->lines = 0u;
+    pbuf->busy = FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   , Ͱÿ벹LOGNET_RATE
+ * @param[in]  None
+ *
+ * @retval     TRUE  : 
+ * @retval     FALSE : 
+ ******************************************************************************
+ */
+static bool_e
+lognet_rate_ok(void)
+{
+    uint32_t now = tickGet();
+    uint32_t add = ((now - the_lognet_last_tick) * LOGNET_RATE)
+            / TICKS_PER_SECOND;
+
+    if (add != 0u)
+    {
+        the_lognet_tokens = MIN(LOGNET_RATE, the_lognet_tokens + add);
+        the_lognet_last_tick = now;
+    }
+    if (the_lognet_tokens == 0u)
+    {
+        return FALSE;
+    }
+    the_lognet_tokens--;
+    return TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ѵǰĻ彻tcpip̷߳
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+lognet_flush(void)
+{
+    lognet_buf_t *pbuf = &the_lognet_bufs[the_lognet_cur];
+
+    if ((pbuf->busy == TRUE) || (pbuf->len == 0u))
+    {
+        return;
+    }
+
+    if ((lognet_rate_ok() == FALSE) || (pbuf->pmsg == NULL))
+    {
+        (void)__sync_fetch_and_add(&the_lognet_lost, pbuf->lines);
+        pbuf->len = 0u;
+        pbuf->lines = 0u;
+        return;
+    }
+
+    pbuf->busy = TRUE;
+    if (tcpip_trycallback(pbuf->pmsg) != ERR_OK)
+    {
+        /* tcpip */
+        (void)__sync_fetch_and_add(&the_lognet_lost, pbuf->lines);
+        pbuf->len = 0u;
+        pbuf->lines = 0u;
+        pbuf->busy = FALSE;
+        return;
+    }
+    the_lognet_cur = (the_lognet_cur + 1u) % LOGNET_BUFS;
+}
+
+/**
+ ******************************************************************************
+ * @brief   RFC5424ͷ׷һеǰ, Ųʱȷ
+ * @param[in]  pline : ־()
+ * @param[in]  len   : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+lognet_record(const char_t *pline, uint32_t len)
+{
+    lognet_buf_t *pbuf = &the_lognet_bufs[the_lognet_cur];
+    uint32_t need = the_lognet_hdr_len + len + 1u;
+
+    if ((pbuf->busy == FALSE) && ((pbuf->len + need) > LOGNET_DGRAM_SIZE))
+    {
+        lognet_flush();
+        pbuf = &the_lognet_bufs[the_lognet_cur];
+    }
+    if ((pbuf->busy == TRUE) || ((pbuf->len + need) > LOGNET_DGRAM_SIZE))
+    {
+        /* Ļ嶼ڷ */
+        (void)__sync_fetch_and_add(&the_lognet_lost, 1u);
+        return;
+    }
+
+    memcpy(&pbuf->data[pbuf->len], the_lognet_hdr, the_lognet_hdr_len);
+    pbuf->len += the_lognet_hdr_len;
+    memcpy(&pbuf->data[pbuf->len], pline, len);
+    pbuf->len += len;
+    pbuf->data[pbuf->len++] = '\n';
+    pbuf->lines++;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ־Ŀ: logMsgавһ־, ĩ
+ * @param[in]  pstr : 
+ * @param[in]  len  : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+lognet_sink(const char_t *pstr, uint32_t len)
+{
+    const char_t *pend = pstr + len;
+
+    for (; pstr < pend; pstr++)
+    {
+        if (*pstr == '\n')
+        {
+            if (the_lognet_line_len != 0u)
+            {
+                lognet_record(the_lognet_line, the_lognet_line_len);
+                the_lognet_line_len = 0u;
+            }
+        }
+        else if ((*pstr != '\r')
+                && (the_lognet_line_len < LOGNET_LINE_SIZE))
+        {
+            the_lognet_line[the_lognet_line_len++] = *pstr;
+        }
+    }
+    lognet_flush();
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʼUDP־ת, tcpip_init֮
+ * @param[in]  pserver : syslogIP, "192.168.1.10"
+ * @param[in]  port    : ˿, 0ʹ514
+ * @param[in]  phost   : , дRFC5424HOSTNAMEֶ
+ *
+ * @retval  OK      : ʼɹ
+ * @retval  ERROR   : ʼʧ
+ ******************************************************************************
+ */
+status_t
+lognet_init(const char_t *pserver, uint16_t port, const char_t *phost)
+{
+    uint32_t i;
+    int32_t len;
+
+    if ((pserver == NULL) || (phost == NULL))
+    {
+        return ERROR;
+    }
+    the_lognet_server.addr = ipaddr_addr(pserver);
+    if (the_lognet_server.addr == IPADDR_NONE)
+    {
+        return ERROR;
+    }
+    the_lognet_port = (port == 0u) ? 514u : port;
+
+    len = snprintf(the_lognet_hdr, sizeof(the_lognet_hdr),
+            "<%u>1 - %s mxos - - - ", LOGNET_PRI, phost);
+    if ((len < 0) || (len >= (int32_t)sizeof(the_lognet_hdr)))
+    {
+        return ERROR;
+    }
+    the_lognet_hdr_len = (uint32_t)len;
+
+    for (i = 0u; i < LOGNET_BUFS; i++)
+    {
+        if (the_lognet_bufs[i].pmsg == NULL)
+        {
+            the_lognet_bufs[i].pmsg =
+                    tcpip_callbackmsg_new(lognet_send_cb, &the_lognet_bufs[i]);
+        }
+        if (the_lognet_bufs[i].pmsg == NULL)
+        {
+            return ERROR;
+        }
+    }
+    the_lognet_last_tick = tickGet();
+
+    return loglib_sink_add(lognet_sink);
+}
+
+/**
+ ******************************************************************************
+ * @brief   UDP־ת״̬
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+lognet_show_info(void)
+{
+    printf("  LOG NET INFOMATION\n");
+    printf("server:%u.%u.%u.%u:%u\n",
+            ip4_addr1(&the_lognet_server), ip4_addr2(&the_lognet_server),
+            ip4_addr3(&the_lognet_server), ip4_addr4(&the_lognet_server),
+            the_lognet_port);
+    printf("datagrams sent:%u  lines lost:%u\n", the_lognet_sent,
+            the_lognet_lost);
+    printf("\n");
+}
+
+/*SHELL CMD FOR LOGNET*/
+uint32_t
+do_lognet(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    lognet_show_info();
+    return 0;
+}
+
+SHELL_CMD(lognet, 1, do_lognet, "lognet -- show udp log state\r\n");
+
+/*--------------------------------logNetLib.c--------------------------------*/
@@ -83,9 +83,6 @@ typedef u32_t sys_prot_t;
   printf("Assertion \"%s\" failed at line %d in %s\n", message, __LINE__, __FILE__); \
   fflush(NULL);handler;} } while(0)
 
-/* C runtime functions redefined */
-#define snprintf _snprintf
-
 u32_t dns_lookup_external_hosts_file(const char *name);
 
 #define LWIP_RAND() ((u32_t)rand())
@@ -134,6 +134,7 @@ status_t
 memlib_add(uint32_t start, uint32_t end)
 {
     heap_t *pfirst = NULL;
+    uint32_t key;
     heap_t *ptail = NULL;
 
     //todo: ֹظ
@@ -160,9 +161,9 @@ memlib_add(uint32_t start, uint32_t end)
     {
         InitListHead(&the_heap_list);
     }
-    intLock();
+    key = intLock();
     ListAddTail(&pfirst->node, &the_heap_list);
-    intUnlock();
+    intUnlock(key);
     the_totle_size += end - start;
 
     return OK;
@@ -180,6 +181,7 @@ void *
 malloc(size_t size)
 {
     void *p = NULL;
+    uint32_t key;
     struct ListNode *piter;
 
     size_t alloc_size;
@@ -195,7 +197,7 @@ malloc(size_t size)
     /* ʵҪĴС(4ֽڶ)  */
     alloc_size = ALIGN_UP(size);
 
-    intLock();    /* ٽ */
+    key = intLock();    /* ٽ */
 
     LIST_FOR_EACH(piter, &the_heap_list)
     {
@@ -211,7 +213,7 @@ malloc(size_t size)
         }
     }
 
-    intUnlock();  /* ˳ٽ */
+    intUnlock(key);  /* ˳ٽ */
 
     return NULL;
 
@@ -242,7 +244,7 @@ do_alloc:
         /* ڵӵڴfree */
         ListAddHead(&pnext->node, &the_heap_list);
     }
-    intUnlock();  /* ˳ٽ */
+    intUnlock(key);  /* ˳ٽ */
 
     /* ڴַ ,עnodeռд*/
     p = &pheap->node;
@@ -262,6 +264,7 @@ void
 free(void *p)
 {
     heap_t *pheap;
+    uint32_t key;
     heap_t *ptmp;
 
     if (the_heap_list.pNextNode == NULL)
@@ -271,7 +274,7 @@ free(void *p)
 
     if (ALIGN_UP((uint32_t)p) != (uint32_t)p)
     {
-        logmsg("Warning: can not free block at[0x%08x].\n", p);
+        LOG_WARN(LOG_MOD_MEM, "Warning: can not free block at[0x%08x].\n", p);
         return;
     }
 
@@ -282,19 +285,19 @@ free(void *p)
     }
     if (pheap->magic != MAGIC_NUM)
     {
-        logmsg("Warning: mem over write, can not free at[0x%08x].\n",
+        LOG_WARN(LOG_MOD_MEM, "Warning: mem over write, can not free at[0x%08x].\n",
                 &pheap->node);
         return;
     }
 
-    intLock();    /* ٽ */
+    key = intLock();    /* ٽ */
 
     /* һڵΪfree״̬ */
     ptmp = heap_next(pheap);
 
     if (ptmp->magic != MAGIC_NUM)
     {
-        logmsg("Warning: mem over write at[0x%08x].\n", &ptmp->node);
+        LOG_WARN(LOG_MOD_MEM, "Warning: mem over write at[0x%08x].\n", &ptmp->node);
     }
 
     if (IS_FREE(ptmp->cursize))
@@ -324,7 +327,7 @@ free(void *p)
         ListAddHead(&pheap->node, &the_heap_list);
     }
 
-    intUnlock();   /* ˳ٽ */
+    intUnlock(key);   /* ˳ٽ */
 }
 
 /**
@@ -343,6 +346,7 @@ void
 showMenInfo(void)
 {
     struct ListNode *piter;
+    uint32_t key;
     heap_t *pheap;
     uint32_t TotalFreeSize = 0u;
     uint32_t MaxSize = 0u;
@@ -354,7 +358,7 @@ showMenInfo(void)
         return ;
     }
 
-    intLock();    /* ٽ */
+    key = intLock();    /* ٽ */
     /* freeڴ */
     LIST_FOR_EACH(piter, &the_heap_list)
     {
@@ -362,7 +366,7 @@ showMenInfo(void)
         pheap = MemToObj(piter, heap_t, node);
         if (pheap->magic != MAGIC_NUM)
         {
-            logmsg("Warning: mem over write at[0x%08x].\n", &pheap->node);
+            LOG_WARN(LOG_MOD_MEM, "Warning: mem over write at[0x%08x].\n", &pheap->node);
         }
         if (pheap->cursize > MaxSize)
         {
@@ -374,7 +378,7 @@ showMenInfo(void)
         }
         TotalFreeSize += pheap->cursize;
     }
-    intUnlock();   /* ˳ٽ */
+    intUnlock(key);   /* ˳ٽ */
 
     printf("********** Heap Monitor ***********\n");
     printf(" TotalHeapMem = %4d Kb  %4d Byte\n", the_totle_size / 1024, the_totle_size % 1024);
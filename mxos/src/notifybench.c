@@ -0,0 +1,230 @@
+/**
+ ******************************************************************************
+ * @file       notifybench.c
+ * @brief      ֪ͨӳٲ.
+ * @details    һежϺNVIC->STIRж, ISRֱsemGive
+ *             taskNotifyGiveһȼĵȴ, DWTڼ
+ *             ӴȴsemTake/taskNotifyTakeص, Ա
+ *             ַʽжϻĿ. STIRд롢жں
+ *             лĹ̶, ַʽͬ.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <types.h>
+#include <shell.h>
+#include <intLib.h>
+#include <taskLib.h>
+#include <oshook.h>
+#include <oscfg.h>
+#include <FreeRTOS.h>
+#if CORE_TYPE == CORE_CM3
+#include <core_cm3.h>
+#elif  CORE_TYPE == CORE_CM4
+#include <core_cm4.h>
+#endif
+
+#ifndef INCLUDE_NOTIFY_BENCH
+# define INCLUDE_NOTIFY_BENCH       (0u)    /**< ֪ͨӳٲ */
+#endif
+
+#if (INCLUDE_NOTIFY_BENCH == 1u) && (configUSE_TASK_NOTIFICATIONS == 1)
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define NOTIFYBENCH_LOOPS         (100u)    /**< ÿַʽ */
+#define NOTIFYBENCH_PRIORITY        (0u)    /**< ȴȼ() */
+#define NOTIFYBENCH_STK_SIZE      (512u)    /**< ȴջ */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static SEM_ID the_notifybench_sem = NULL;
+static TASK_ID the_notifybench_tid = NULL;
+static volatile uint32_t the_notifybench_stamp;
+static volatile bool_e the_notifybench_done;
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief      ISR, semGiveѵȴ
+ ******************************************************************************
+ */
+static void
+notifybench_sem_isr(void)
+{
+    (void)semGive(the_notifybench_sem);
+}
+
+/**
+ ******************************************************************************
+ * @brief      ISR, taskNotifyGiveѵȴ
+ ******************************************************************************
+ */
+static void
+notifybench_notify_isr(void)
+{
+    (void)taskNotifyGive(the_notifybench_tid);
+}
+
+/**
+ ******************************************************************************
+ * @brief      ȴ, semTakeʱ¼ʱ
+ ******************************************************************************
+ */
+static void
+notifybench_sem_task(void *arg)
+{
+    (void)arg;
+    while (TRUE)
+    {
+        if (semTake(the_notifybench_sem, WAIT_FOREVER) == OK)
+        {
+            the_notifybench_stamp = DWT_CYCCNT;
+            the_notifybench_done = TRUE;
+        }
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief      ȴ, taskNotifyTakeʱ¼ʱ
+ ******************************************************************************
+ */
+static void
+notifybench_notify_task(void *arg)
+{
+    (void)arg;
+    while (TRUE)
+    {
+        if (taskNotifyTake(TRUE, WAIT_FOREVER) != 0u)
+        {
+            the_notifybench_stamp = DWT_CYCCNT;
+            the_notifybench_done = TRUE;
+        }
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief      һֻѷʽжϲӳ
+ * @param[in]  pname   : ʽ
+ * @param[in]  irq_num : жϺ
+ * @param[in]  isr     : ISR
+ * @param[in]  entry   : ȴִ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+notifybench_run(const char *pname, uint32_t irq_num, VOIDFUNCPTR isr,
+        OSFUNCPTR entry)
+{
+    uint32_t i;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t min = 0xFFFFFFFFu;
+    uint32_t max = 0u;
+    uint32_t sum = 0u;
+
+    /* ȴȼshell, вڵȴ */
+    the_notifybench_tid = taskSpawn((const signed char * const ) "nbench",
+            NOTIFYBENCH_PRIORITY, NOTIFYBENCH_STK_SIZE, entry, 0);
+    if (the_notifybench_tid == NULL)
+    {
+        printf("%-8s no memory\n", pname);
+        return;
+    }
+
+    (void)intConnect(irq_num, isr, 1u);
+    for (i = 0u; i < NOTIFYBENCH_LOOPS; i++)
+    {
+        the_notifybench_done = FALSE;
+        start = DWT_CYCCNT;
+        NVIC->STIR = irq_num - 16u;
+        while (the_notifybench_done == FALSE)
+        {
+            ;
+        }
+        cycles = the_notifybench_stamp - start;
+        sum += cycles;
+        if (cycles < min)
+        {
+            min = cycles;
+        }
+        if (cycles > max)
+        {
+            max = cycles;
+        }
+    }
+    (void)intDisconnect(irq_num);
+    taskDelete(the_notifybench_tid);
+    the_notifybench_tid = NULL;
+
+    printf("%-8s %6u %6u %6u cycles\n", pname, min,
+            sum / NOTIFYBENCH_LOOPS, max);
+}
+
+/**
+ ******************************************************************************
+ * @brief      notifybench: жϻӳ
+ * @param[in]  argv[1] : õĿжϺ(16 ~ MAX_INT_COUNT)
+ *
+ * @retval     0
+ ******************************************************************************
+ */
+uint32_t
+do_notifybench(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    uint32_t irq_num;
+
+    (void)cmdtp;
+    if (argc < 2u)
+    {
+        printf("usage: notifybench <unused irq>\n");
+        return 1;
+    }
+    irq_num = (uint32_t)strtoul((const char *)argv[1], NULL, 0);
+    if ((irq_num < 16u) || (irq_num > MAX_INT_COUNT))
+    {
+        printf("irq must be 16 ~ %u\n", MAX_INT_COUNT);
+        return 1;
+    }
+    the_notifybench_sem = semBCreate(0);
+    if (the_notifybench_sem == NULL)
+    {
+        printf("no memory\n");
+        return 1;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    printf("notifybench: irq %u, isr -> task wakeup\n", irq_num);
+    printf("            min    avg    max\n");
+    (void)intPrioSet(irq_num, 0xFFu);
+    (void)intEnable(irq_num);
+    notifybench_run("sem", irq_num, (VOIDFUNCPTR)notifybench_sem_isr,
+            notifybench_sem_task);
+    notifybench_run("notify", irq_num, (VOIDFUNCPTR)notifybench_notify_isr,
+            notifybench_notify_task);
+    (void)intDisable(irq_num);
+
+    semDelete(the_notifybench_sem);
+    the_notifybench_sem = NULL;
+
+    return 0;
+}
+
+SHELL_CMD(notifybench, 2, do_notifybench, "notifybench <unused irq>\r\n");
+
+#endif /* INCLUDE_NOTIFY_BENCH */
+/*-------------------------------notifybench.c-------------------------------*/
@@ -18,6 +18,7 @@
 #include <string.h>
 #include <time.h>
 #include <devLib.h>
+#include <taskLib.h>
 #include <osLib.h>
 #include <oscfg.h>
 
@@ -539,6 +540,43 @@ printf_time(const char_t *pinfo,
         daytime.tm_hour, daytime.tm_min, daytime.tm_sec);
 }
 
+/**
+ ******************************************************************************
+ * @brief      localtime_r
+ * @param[in]  pcache : ߳еĻ, secʼΪ-1
+ * @param[in]  sec    : ʱ
+ * @param[out] ptm    : ֽʱ
+ * @retval     None
+ *
+ * @details    뻺ͬһʱֻʱӼ, localtime_r
+ *             ». 治, ʱɵ߻.
+ ******************************************************************************
+ */
+void
+localtime_cached(tm_cache_t *pcache,
+        time_t sec,
+        struct tm *ptm)
+{
+    int32_t daysec;
+
+    if (pcache->sec != (time_t)-1)
+    {
+        daysec = (int32_t)(sec - pcache->sec) + (pcache->tm.tm_hour * 3600)
+                + (pcache->tm.tm_min * 60) + pcache->tm.tm_sec;
+        if ((daysec >= 0) && (daysec < 86400))
+        {
+            *ptm = pcache->tm;
+            ptm->tm_hour = daysec / 3600;
+            ptm->tm_min = (daysec / 60) % 60;
+            ptm->tm_sec = daysec % 60;
+            return;
+        }
+    }
+    (void)localtime_r(&sec, ptm);
+    pcache->sec = sec;
+    pcache->tm = *ptm;
+}
+
 /**
  ******************************************************************************
  * @brief      ӡǰʱ
@@ -549,9 +587,13 @@ printf_time(const char_t *pinfo,
 void
 print_logtime(void)
 {
+    static tm_cache_t the_cache = { .sec = (time_t)-1 };
     struct tm daytime;
     time_t stime = time(NULL);
-    (void)localtime_r(&stime, &daytime);
+
+    taskLock();
+    localtime_cached(&the_cache, stime, &daytime);
+    taskUnlock();
     (void)printf("[%04d-%02d-%02d %02d:%02d:%02d]  ",
         daytime.tm_year + 1900, daytime.tm_mon + 1, daytime.tm_mday,
         daytime.tm_hour, daytime.tm_min, daytime.tm_sec);
@@ -186,6 +186,34 @@ _default_bsp_get_max_int_count(void)
     return 103;
 }
 
+/**
+ ******************************************************************************
+ * @brief  7. Ĭø߾ȶʱȽֵ, ֧
+ * @param[in]  stamp : Ƚֵ(bsp_timer_get)
+ *
+ * @retval    ERROR
+ ******************************************************************************
+ */
+status_t
+_default_bsp_hrtimer_set(uint32_t stamp)
+{
+    return ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief  7. ĬϹرո߾ȶʱȽͨ
+ * @param[in]  None
+ *
+ * @retval    None
+ ******************************************************************************
+ */
+void
+_default_bsp_hrtimer_stop(void)
+{
+
+}
+
 /**
   *@brief MXOSĬϹӺ
   */
@@ -197,6 +225,8 @@ _default_bsp_get_max_int_count(void)
 #pragma weak bsp_timer_get          = _default_bsp_timer_get
 #pragma weak bsp_get_mcu_clk        = _default_bsp_mcu_clk
 #pragma weak bsp_get_max_int_count  = _default_bsp_get_max_int_count
+#pragma weak bsp_hrtimer_set        = _default_bsp_hrtimer_set
+#pragma weak bsp_hrtimer_stop       = _default_bsp_hrtimer_stop
 
 
 /*--------------------------------oshook.c-----------------------------------*/
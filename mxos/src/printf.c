@@ -5,230 +5,1236 @@
  *             sprintf() and so on. This reduces the memory footprint of the
  *             binary when using those methods, compared to the libc
  *             implementation.
+ * @details    иʽһнĸʽfmt_format(), ֧:
+ *             - ־ '-' '+' ' ' '#' '0', 뾫('*')
+ *             -  hh h l ll z t j
+ *             - ת %d %i %u %o %x %X %c %s %p %f %F %%
+ *             תÿδλʮ(), 64λȰ1e8ֶ,
+ *             λ.
+ *
+ *             жеĿֽ̨æȴ, ׷ӵ
+ *             жλ, ɿ̨ttyķͿжϻеһ
+ *             ȡ. 쳣console_panic()Ϊͬ.
  * @copyright
  *
  ******************************************************************************
  */
 #include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
 #include <types.h>
 #include <devLib.h>
 #include <intLib.h>
 #include <oshook.h>
+#include <ttyLib.h>
+#include <debug.h>
+#include <taskLib.h>
 #include <oscfg.h>
 
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef INCLUDE_PRINTF_FLOAT
+# define INCLUDE_PRINTF_FLOAT        (1u)    /**< ֧%fʽ */
+#endif
+
+#define FL_LEFT         0x01u   /**< '-'  */
+#define FL_ZERO         0x02u   /**< '0'  */
+#define FL_PLUS         0x04u   /**< '+'  */
+#define FL_SPACE        0x08u   /**< ' ' ǰո */
+#define FL_ALT          0x10u   /**< '#' ʽ */
+#define FL_UPPER        0x20u   /**< дĸ */
+#define FL_PREC         0x40u   /**< ָ˾ */
+
+#define FMT_NUM_BUF_LEN     (24u)   /**< 64λ˽22λ */
+#define FMT_CONSOLE_CHUNK   (64u)   /**< ̨ʱջϻ */
+#define FMT_MAX_FLOAT_PREC  (9u)    /**< %fСλ */
+
+#ifndef CONSOLE_ISR_RING_SIZE
+# define CONSOLE_ISR_RING_SIZE     (512u)   /**< жС(2) */
+#endif
+
+#ifndef CONSOLE_REDIRECTS
+# define CONSOLE_REDIRECTS           (2u)   /**< ض */
+#endif
+
+#define CONSOLE_ISR_RING_MASK   (CONSOLE_ISR_RING_SIZE - 1u)
+C_ASSERT((CONSOLE_ISR_RING_SIZE & CONSOLE_ISR_RING_MASK) != 0u);
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ʽĿ */
+typedef struct
+{
+    char_t *buf;    /**< Ŀ껺 */
+    size_t size;    /**< С */
+    size_t len;     /**< дֽ */
+    size_t count;   /**< Ѹʽַ(ɴsize) */
+    bool_e console; /**< TRUE: bufʱ̨; FALSE: ֶ */
+} fmt_out_t;
+
+/**
+ * жλ(ߵ, )
+ *
+ * (ж)CASԤ[reserve, reserve+n)󿽱; Ƕ׼nest
+ * ʱ˵ûδɵĿ, Űcommitƽreserve. ֻȡ
+ * [rd, commit)֮. Cortex-MжϸǶ, ڲж
+ * , commitԽδд.
+ */
+typedef struct
+{
+    volatile uint32_t reserve;  /**< Ԥдλ */
+    volatile uint32_t commit;   /**< дλ */
+    volatile uint32_t rd;       /**< λ */
+    volatile uint32_t nest;     /**< д */
+    volatile uint32_t lost;     /**< ֽ */
+    uint8_t buf[CONSOLE_ISR_RING_SIZE];
+} con_ring_t;
+
+/** ض(telnetỰ) */
+typedef struct
+{
+    TASK_ID tid;            /**< ض, NULLΪ */
+    console_out_t out;      /**<  */
+    void *pctx;             /**<  */
+} con_redirect_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+/** 00~99λʮַ */
+static const char_t the_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char_t the_hex_lower[] = "0123456789abcdef";
+static const char_t the_hex_upper[] = "0123456789ABCDEF";
+
+#if (INCLUDE_PRINTF_FLOAT == 1u)
+static const uint32_t the_pow10[FMT_MAX_FLOAT_PREC + 1] =
+{
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u,
+    100000000u, 1000000000u
+};
+#endif
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static con_ring_t the_con_ring;
+static volatile bool_e the_con_panic = FALSE;   /**< ͬģʽ */
+static int32_t the_con_bound_fd = -1;           /**< Ѱ󶨷жϵĿ̨ */
+static con_redirect_t the_con_redirects[CONSOLE_REDIRECTS];
+static volatile uint32_t the_con_redirect_num = 0u;  /**< ض */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ж׷ݵж, , Ųʱζ
+ * @param[in]  *pstr    : 
+ * @param[in]  len      : 
+ *
+ * @retval     ʵ׷ӵֽ(0len)
+ ******************************************************************************
+ */
+static size_t
+con_ring_put(const char_t *pstr, size_t len)
+{
+    con_ring_t *pring = &the_con_ring;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t n;
+    uint32_t i;
+
+    (void)__sync_fetch_and_add(&pring->nest, 1u);
+    do
+    {
+        head = pring->reserve;
+        /* Ųʱζ,  */
+        n = CONSOLE_ISR_RING_SIZE - (head - pring->rd);
+        n = (n >= len) ? len : 0u;
+    } while ((n != 0u)
+            && !__sync_bool_compare_and_swap(&pring->reserve, head, head + n));
+
+    for (i = 0u; i < n; i++)
+    {
+        pring->buf[(head + i) & CONSOLE_ISR_RING_MASK] = (uint8_t)pstr[i];
+    }
+
+    /* ˳ʱԤ */
+    if (__sync_sub_and_fetch(&pring->nest, 1u) == 0u)
+    {
+        do
+        {
+            tail = pring->commit;
+            head = pring->reserve;
+        } while ((pring->nest == 0u)
+                && ((int32_t)(head - tail) > 0)
+                && !__sync_bool_compare_and_swap(&pring->commit, tail, head));
+    }
+
+    if (n < len)
+    {
+        (void)__sync_fetch_and_add(&pring->lost, len - n);
+    }
+    return n;
+}
+
+/**
+ ******************************************************************************
+ * @brief   жȡ(ڷжϻе)
+ * @param[out] *pbuf    : 
+ * @param[in]  size     : С
+ *
+ * @retval     ȡֽ
+ ******************************************************************************
+ */
+static size_t
+con_ring_get(uint8_t *pbuf, size_t size)
+{
+    con_ring_t *pring = &the_con_ring;
+    uint32_t tail;
+    uint32_t n;
+    uint32_t i;
+
+    /* жͬʱȡ, λͬCASƽ */
+    do
+    {
+        tail = pring->rd;
+        n = pring->commit - tail;
+        if (n > size)
+        {
+            n = size;
+        }
+        for (i = 0u; i < n; i++)
+        {
+            pbuf[i] = pring->buf[(tail + i) & CONSOLE_ISR_RING_MASK];
+        }
+    } while ((n != 0u)
+            && !__sync_bool_compare_and_swap(&pring->rd, tail, tail + n));
+
+    return n;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ̨ttyͿжȡһжֽ
+ * @param[out] *pch     : ֽ
+ *
+ * @retval     1 : ȡ
+ * @retval     0 : 
+ ******************************************************************************
+ */
+uint16_t
+console_isr_getchar(uint8_t *pch)
+{
+    return (uint16_t)con_ring_get(pch, 1u);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡжֽ
+ * @param[in]  None
+ *
+ * @retval     ֽ
+ ******************************************************************************
+ */
+uint32_t
+console_isr_lost(void)
+{
+    return the_con_ring.lost;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ˳ͬ(panic)ģʽ
+ * @param[in]  enable   : TRUE, FALSE˳
+ *
+ * @retval     None
+ *
+ * @details ʱbsp_putcharжϻлѹ, ֮
+ *          ֱӵbsp_putchar, жϺ. 쳣.
+ ******************************************************************************
+ */
+void
+console_panic(bool_e enable)
+{
+    uint8_t ch;
+
+    if (enable == TRUE)
+    {
+        the_con_panic = TRUE;
+        while (con_ring_get(&ch, 1u) != 0u)
+        {
+            bsp_putchar((char_t)ch);
+        }
+    }
+    else
+    {
+        the_con_panic = FALSE;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ָĿ̨ضout
+ * @param[in]  tid  : ID
+ * @param[in]  out  : , ڸе; NULLȡض
+ * @param[in]  pctx : 
+ *
+ * @retval     OK    : ɹ
+ * @retval     ERROR : ض
+ *
+ * @details ֻӰеprintf; жϺpanic߿̨.
+ ******************************************************************************
+ */
+status_t
+console_redirect(TASK_ID tid, console_out_t out, void *pctx)
+{
+    status_t ret = (out == NULL) ? OK : ERROR;
+    uint32_t i;
+
+    if (tid == NULL)
+    {
+        return ERROR;
+    }
+
+    taskLock();
+    for (i = 0u; i < CONSOLE_REDIRECTS; i++)
+    {
+        if (the_con_redirects[i].tid == tid)
+        {
+            the_con_redirects[i].tid = NULL;
+            the_con_redirect_num--;
+        }
+    }
+    for (i = 0u; (out != NULL) && (i < CONSOLE_REDIRECTS); i++)
+    {
+        if (the_con_redirects[i].tid == NULL)
+        {
+            the_con_redirects[i].out = out;
+            the_con_redirects[i].pctx = pctx;
+            the_con_redirects[i].tid = tid;
+            the_con_redirect_num++;
+            ret = OK;
+            break;
+        }
+    }
+    taskUnlock();
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ажд̨
+ * @param[in]  fd       : ̨
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+console_isr_flush(int32_t fd)
+{
+    uint8_t buf[FMT_CONSOLE_CHUNK];
+    size_t n;
+
+    if (fd != the_con_bound_fd)
+    {
+        /* ̨ʱttyڷͿж˳жϻ */
+        the_con_bound_fd = fd;
+        (void)dev_ioctl(fd, TTY_FIOCONSOLE, NULL);
+    }
+
+    while ((n = con_ring_get(buf, sizeof(buf))) != 0u)
+    {
+        dev_write(fd, buf, (int32_t)n);
+    }
+}
+
 #ifdef putchar
     #undef putchar
 #endif
-int putchar(int c)
+/**
+ ******************************************************************************
+ * @brief   ̨һ, '\n'ǰԶ'\r'
+ * @param[in]  *pstr    : 
+ * @param[in]  len      : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+console_write(const char_t *pstr, size_t len)
 {
     extern int32_t _the_console_fd;
-    extern long xTaskGetSchedulerState( void );
-    if ((intContext() == TRUE) || (_the_console_fd <= 0)) //|| (xTaskGetSchedulerState() != 1))
+    const char_t *pend = pstr + len;
+    const char_t *prun;
+
+    if ((the_con_panic == FALSE) && (_the_console_fd > 0)
+            && (intContext() == TRUE))
     {
-        /* նлδʱֱӵõײ֤ʹtaskDelay */
-        if (c == '\n')
+        /* жֻ׷ӵж, ɷͿжϻȡ */
+        while (pstr < pend)
         {
-            bsp_putchar('\r');
+            prun = pstr;
+            while ((prun < pend) && (*prun != '\n'))
+            {
+                prun++;
+            }
+            (void)con_ring_put(pstr, prun - pstr);
+            if (prun < pend)
+            {
+                (void)con_ring_put("\r\n", 2);
+                prun++;
+            }
+            pstr = prun;
         }
-        bsp_putchar((unsigned char)c);
+        ttylib_console_kick();
+        return;
     }
-    else
+
+    /* ض(telnetỰ)̨tty, ڵײж */
+    if ((the_con_redirect_num != 0u) && (the_con_panic == FALSE)
+            && (intContext() == FALSE))
+    {
+        TASK_ID tid = taskIdSelf();
+        uint32_t i;
+
+        for (i = 0u; i < CONSOLE_REDIRECTS; i++)
+        {
+            if (the_con_redirects[i].tid == tid)
+            {
+                the_con_redirects[i].out(the_con_redirects[i].pctx, pstr, len);
+                return;
+            }
+        }
+    }
+
+    if ((the_con_panic == TRUE) || (intContext() == TRUE)
+            || (_the_console_fd <= 0))
+    {
+        /* panicģʽδʱֱӵõײ֤ʹtaskDelay */
+        for (; pstr < pend; pstr++)
+        {
+            if (*pstr == '\n')
+            {
+                bsp_putchar('\r');
+            }
+            bsp_putchar(*pstr);
+        }
+        return;
+    }
+
+    /* жлѹ, Ⱥ˳ */
+    console_isr_flush(_the_console_fd);
+
+    /* '\n'ֶ, ÿεһdev_write */
+    while (pstr < pend)
     {
-        if((c) == '\n')
+        prun = pstr;
+        while ((prun < pend) && (*prun != '\n'))
+        {
+            prun++;
+        }
+        if (prun > pstr)
+        {
+            dev_write(_the_console_fd, (const uint8_t *)pstr, prun - pstr);
+        }
+        if (prun < pend)
         {
-            char ch = '\r';
-            dev_write(_the_console_fd, (uint8_t* )&ch, 1);
+            dev_write(_the_console_fd, (const uint8_t *)"\r\n", 2);
+            prun++;
         }
-        dev_write(_the_console_fd, (uint8_t* )&c, 1);
+        pstr = prun;
     }
+}
+
+int putchar(int c)
+{
+    char_t ch = (char_t)c;
+
+    console_write(&ch, 1);
     return 1;
 }
 
 void printstr(const char *pStr, int len)
 {
-    while (len--) {
-        putchar(*pStr++);
+    if (len > 0)
+    {
+        console_write(pStr, (size_t)len);
     }
 }
 
 signed int puts(const char *pStr)
 {
-    signed int num = 0;
-    while (*pStr != 0) {
+    size_t num = strlen(pStr);
+
+    console_write(pStr, num);
+    console_write("\n", 1);
+    return (signed int)num;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ŀдһ
+ * @param[in]  *pout    : Ŀ
+ * @param[in]  *pstr    : 
+ * @param[in]  n        : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+out_write(fmt_out_t *pout, const char_t *pstr, size_t n)
+{
+    size_t room;
+
+    pout->count += n;
+    if (pout->console == TRUE)
+    {
+        while (n > 0)
+        {
+            room = pout->size - pout->len;
+            if (room > n)
+            {
+                room = n;
+            }
+            memcpy(pout->buf + pout->len, pstr, room);
+            pout->len += room;
+            pstr += room;
+            n -= room;
+            if (pout->len == pout->size)
+            {
+                console_write(pout->buf, pout->len);
+                pout->len = 0;
+            }
+        }
+        return;
+    }
 
-        putchar(*pStr++);
-        num++;
+    /* ַ, һֽڸ'\0' */
+    if (pout->len + 1 >= pout->size)
+    {
+        return;
     }
-    char c ='\n';
-    putchar(c);
-    return num;
+    room = pout->size - 1 - pout->len;
+    if (room > n)
+    {
+        room = n;
+    }
+    memcpy(pout->buf + pout->len, pstr, room);
+    pout->len += room;
 }
 
-static void printchar(char **str, int c)
+/**
+ ******************************************************************************
+ * @brief   Ŀдnַͬ(ڿȺ;)
+ * @param[in]  *pout    : Ŀ
+ * @param[in]  c        : ַ(' ''0')
+ * @param[in]  n        : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+out_pad(fmt_out_t *pout, char_t c, int32_t n)
 {
-    if (str) {
-        **str = c;
-        ++(*str);
+    static const char_t spaces[] = "                ";
+    static const char_t zeros[]  = "0000000000000000";
+    const char_t *pfill = (c == '0') ? zeros : spaces;
+
+    while (n > 0)
+    {
+        size_t chunk = (n > (int32_t)(sizeof(spaces) - 1)) ?
+                (sizeof(spaces) - 1) : (size_t)n;
+        out_write(pout, pfill, chunk);
+        n -= (int32_t)chunk;
     }
-    else (void)putchar(c);
 }
 
-#define PAD_RIGHT 1
-#define PAD_ZERO 2
+/**
+ ******************************************************************************
+ * @brief   32λ޷תʮַ(ÿλ)
+ * @param[in]  u        : ֵ
+ * @param[in]  *pend    : ĩβ, Ӻǰд
+ *
+ * @retval     һַĵַ
+ ******************************************************************************
+ */
+static char_t *
+utoa_dec32(uint32_t u, char_t *pend)
+{
+    uint32_t q;
+
+    while (u >= 100u)
+    {
+        q = u / 100u;   /* ɱΪ˷ */
+        pend -= 2;
+        memcpy(pend, &the_digit_pairs[(u - (q * 100u)) * 2u], 2);
+        u = q;
+    }
+    if (u >= 10u)
+    {
+        pend -= 2;
+        memcpy(pend, &the_digit_pairs[u * 2u], 2);
+    }
+    else
+    {
+        *--pend = (char_t)('0' + u);
+    }
+    return pend;
+}
+
+/**
+ ******************************************************************************
+ * @brief   64λ޷תʮַ
+ * @param[in]  u        : ֵ
+ * @param[in]  *pend    : ĩβ, Ӻǰд
+ *
+ * @retval     һַĵַ
+ *
+ * @details ֵ416λ, 10000, ÿεõ4λ,
+ *          <10000, һƴӺԲ32λ, ȫֻ32λ,
+ *          libgcc64λ; 32λΪ0תutoa_dec32
+ ******************************************************************************
+ */
+static char_t *
+utoa_dec64(uint64_t u, char_t *pend)
+{
+    uint32_t part[4];   /* 16λһ, part[0]Ϊ߶ */
+    uint32_t r;
+    uint32_t i;
+    char_t *p;
+
+    part[0] = (uint32_t)(u >> 48) & 0xFFFFu;
+    part[1] = (uint32_t)(u >> 32) & 0xFFFFu;
+    part[2] = (uint32_t)(u >> 16) & 0xFFFFu;
+    part[3] = (uint32_t)u & 0xFFFFu;
+
+    while ((part[0] | part[1]) != 0u)
+    {
+        r = 0u;
+        for (i = 0u; i < 4u; i++)
+        {
+            r = (r << 16) | part[i];
+            part[i] = r / 10000u;
+            r -= part[i] * 10000u;
+        }
+        p = utoa_dec32(r, pend);
+        /* ֶڲ4λʱ */
+        while (p > pend - 4)
+        {
+            *--p = '0';
+        }
+        pend = p;
+    }
+    return utoa_dec32((part[2] << 16) | part[3], pend);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ޷ת2ݽַ(8/16)
+ * @param[in]  u        : ֵ
+ * @param[in]  shift    : ÿλı(34)
+ * @param[in]  *pdigits : ַ
+ * @param[in]  *pend    : ĩβ, Ӻǰд
+ *
+ * @retval     һַĵַ
+ ******************************************************************************
+ */
+static char_t *
+utoa_pow2(uint64_t u, uint32_t shift, const char_t *pdigits, char_t *pend)
+{
+    uint32_t mask = (1u << shift) - 1u;
+    uint32_t lo;
+
+    /* 32λΪ0ʱֻ32λ */
+    while (u > 0xFFFFFFFFull)
+    {
+        *--pend = pdigits[(uint32_t)u & mask];
+        u >>= shift;
+    }
+    lo = (uint32_t)u;
+    do
+    {
+        *--pend = pdigits[lo & mask];
+        lo >>= shift;
+    } while (lo != 0u);
+
+    return pend;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡȼ־һתõ
+ * @param[in]  *pout    : Ŀ
+ * @param[in]  *pprefix : ǰ׺(Ż0x), Ϊմ
+ * @param[in]  *pdigits : ַ
+ * @param[in]  ndigits  : ָ
+ * @param[in]  zeros    : ǰ貹'0'(Ծ)
+ * @param[in]  tzeros   : ֺ貹'0'(󸡵)
+ * @param[in]  *ptail   : ֺĸӲ(С), ΪNULL
+ * @param[in]  ntail    : Ӳֳ
+ * @param[in]  ntzeros  : Ӳֺ貹'0'(FMT_MAX_FLOAT_PRECСλ)
+ * @param[in]  flags    : ־
+ * @param[in]  width    : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+out_number(fmt_out_t *pout, const char_t *pprefix,
+        const char_t *pdigits, int32_t ndigits, int32_t zeros,
+        int32_t tzeros, const char_t *ptail, int32_t ntail, int32_t ntzeros,
+        uint32_t flags, int32_t width)
+{
+    int32_t nprefix = (int32_t)strlen(pprefix);
+    int32_t pad = width - nprefix - zeros - ndigits - tzeros - ntail
+            - ntzeros;
+
+    if ((flags & (FL_LEFT | FL_ZERO)) == FL_ZERO)
+    {
+        /* ǰ׺֮ */
+        zeros += (pad > 0) ? pad : 0;
+        pad = 0;
+    }
+    if (!(flags & FL_LEFT))
+    {
+        out_pad(pout, ' ', pad);
+    }
+    out_write(pout, pprefix, (size_t)nprefix);
+    out_pad(pout, '0', zeros);
+    out_write(pout, pdigits, (size_t)ndigits);
+    out_pad(pout, '0', tzeros);
+    if (ntail > 0)
+    {
+        out_write(pout, ptail, (size_t)ntail);
+    }
+    out_pad(pout, '0', ntzeros);
+    if (flags & FL_LEFT)
+    {
+        out_pad(pout, ' ', pad);
+    }
+}
 
-static int prints(char **out, const char *string, int width, int pad)
+/**
+ ******************************************************************************
+ * @brief   ʽ
+ * @param[in]  *pout    : Ŀ
+ * @param[in]  u        : ֵľֵ
+ * @param[in]  neg      : ǷΪ
+ * @param[in]  base     : (8/10/16)
+ * @param[in]  flags    : ־
+ * @param[in]  width    : 
+ * @param[in]  prec     : (ָ)
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+fmt_integer(fmt_out_t *pout, uint64_t u, bool_e neg, uint32_t base,
+        uint32_t flags, int32_t width, int32_t prec)
 {
-    register int pc = 0, padchar = ' ';
+    char_t buf[FMT_NUM_BUF_LEN];
+    char_t *pend = buf + sizeof(buf);
+    char_t *p = pend;
+    const char_t *pprefix = "";
+    int32_t ndigits;
+    int32_t zeros = 0;
 
-    if (width > 0) {
-        register int len = 0;
-        register const char *ptr;
-        for (ptr = string; *ptr; ++ptr) ++len;
-        if (len >= width) width = 0;
-        else width -= len;
-        if (pad & PAD_ZERO) padchar = '0';
+    if (flags & FL_PREC)
+    {
+        flags &= ~FL_ZERO;  /* ָʱ'0'־ */
+    }
+    else
+    {
+        prec = 1;
     }
-    if (!(pad & PAD_RIGHT)) {
-        for ( ; width > 0; --width) {
-            printchar (out, padchar);
-            ++pc;
+
+    if ((u != 0u) || (prec != 0))
+    {
+        if (base == 10u)
+        {
+            p = (u > 0xFFFFFFFFull) ? utoa_dec64(u, pend)
+                                    : utoa_dec32((uint32_t)u, pend);
+        }
+        else
+        {
+            p = utoa_pow2(u, (base == 16u) ? 4u : 3u,
+                    (flags & FL_UPPER) ? the_hex_upper : the_hex_lower, pend);
         }
     }
-    for ( ; *string ; ++string) {
-        printchar (out, *string);
-        ++pc;
+    ndigits = (int32_t)(pend - p);
+    if (prec > ndigits)
+    {
+        zeros = prec - ndigits;
+    }
+
+    if (base == 10u)
+    {
+        pprefix = neg ? "-" : (flags & FL_PLUS) ? "+"
+                : (flags & FL_SPACE) ? " " : "";
     }
-    for ( ; width > 0; --width) {
-        printchar (out, padchar);
-        ++pc;
+    else if (flags & FL_ALT)
+    {
+        if (base == 16u)
+        {
+            if (u != 0u)
+            {
+                pprefix = (flags & FL_UPPER) ? "0X" : "0x";
+            }
+        }
+        else if (zeros == 0)
+        {
+            if ((ndigits == 0) || (*p != '0'))
+            {
+                zeros = 1;  /* ˽'#'֤λΪ0 */
+            }
+        }
     }
 
-    return pc;
+    out_number(pout, pprefix, p, ndigits, zeros, 0, NULL, 0, 0, flags,
+            width);
 }
 
-/* the following should be enough for 32 bit int */
-#define PRINT_BUF_LEN 12
-
-static int printi(char **out, int i, int b, int sg, int width, int pad, int letbase)
+#if (INCLUDE_PRINTF_FLOAT == 1u)
+/**
+ ******************************************************************************
+ * @brief   Զ㷽ʽʽ(%f)
+ * @param[in]  *pout    : Ŀ
+ * @param[in]  v        : ֵ
+ * @param[in]  flags    : ־
+ * @param[in]  width    : 
+ * @param[in]  prec     : Сλ
+ *
+ * @retval     None
+ *
+ * @note    ֳ64λʱС'0'λ, doubleΪ;
+ *          СFMT_MAX_FLOAT_PRECλʱ, λ'0'
+ ******************************************************************************
+ */
+static void
+fmt_float(fmt_out_t *pout, double v, uint32_t flags, int32_t width,
+        int32_t prec)
 {
-    char print_buf[PRINT_BUF_LEN];
-    register char *s;
-    register int t, neg = 0, pc = 0;
-    register unsigned int u = i;
+    char_t ibuf[FMT_NUM_BUF_LEN];
+    char_t fbuf[FMT_MAX_FLOAT_PREC + 1];
+    char_t *pend = ibuf + sizeof(ibuf);
+    char_t *p;
+    const char_t *pprefix;
+    bool_e neg = FALSE;
+    uint64_t ipart;
+    uint32_t fpart = 0u;
+    int32_t nfrac = 0;
+    int32_t ntzeros = 0;
+    int32_t exp10 = 0;
+    double frac;
 
-    if (i == 0) {
-        print_buf[0] = '0';
-        print_buf[1] = '\0';
-        return prints (out, print_buf, width, pad);
+    if (!(flags & FL_PREC))
+    {
+        prec = 6;
+    }
+    if (prec > (int32_t)FMT_MAX_FLOAT_PREC)
+    {
+        ntzeros = prec - (int32_t)FMT_MAX_FLOAT_PREC;
+        prec = FMT_MAX_FLOAT_PREC;
     }
 
-    if (sg && b == 10 && i < 0) {
-        neg = 1;
-        u = -i;
+    if (v < 0.0)
+    {
+        neg = TRUE;
+        v = -v;
     }
+    pprefix = neg ? "-" : (flags & FL_PLUS) ? "+"
+            : (flags & FL_SPACE) ? " " : "";
 
-    s = print_buf + PRINT_BUF_LEN-1;
-    *s = '\0';
+    if (v != v)
+    {
+        out_number(pout, "", (flags & FL_UPPER) ? "NAN" : "nan", 3, 0,
+                0, NULL, 0, 0, flags & ~FL_ZERO, width);
+        return;
+    }
+    if (v > 1.7976931348623157e308)
+    {
+        out_number(pout, pprefix, (flags & FL_UPPER) ? "INF" : "inf", 3, 0,
+                0, NULL, 0, 0, flags & ~FL_ZERO, width);
+        return;
+    }
 
-    while (u) {
-        t = u % b;
-        if( t >= 10 )
-            t += letbase - '0' - 10;
-        *--s = t + '0';
-        u /= b;
+    while (v >= 1e19)
+    {
+        v /= 10.0;
+        exp10++;
     }
 
-    if (neg) {
-        if( width && (pad & PAD_ZERO) ) {
-            printchar (out, '-');
-            ++pc;
-            --width;
+    ipart = (uint64_t)v;
+    frac = v - (double)ipart;
+    if (exp10 == 0)
+    {
+        fpart = (uint32_t)((frac * the_pow10[prec]) + 0.5);
+        if (fpart >= the_pow10[prec])
+        {
+            fpart -= the_pow10[prec];
+            ipart++;
         }
-        else {
-            *--s = '-';
+    }
+
+    /* , Сĵλout_number */
+    p = utoa_dec64(ipart, pend);
+
+    /* С */
+    if ((prec > 0) || (flags & FL_ALT))
+    {
+        fbuf[0] = '.';
+        nfrac = 1;
+        if (prec > 0)
+        {
+            char_t *pf = utoa_dec32(fpart, fbuf + 1 + prec);
+            while (pf > fbuf + 1)
+            {
+                *--pf = '0';
+            }
+            nfrac += prec;
         }
     }
 
-    return pc + prints (out, s, width, pad);
+    out_number(pout, pprefix, p, (int32_t)(pend - p), 0, exp10,
+            fbuf, nfrac, ntzeros, flags, width);
 }
+#endif
 
-int print(char **out, const char *format, va_list args )
+/**
+ ******************************************************************************
+ * @brief   ʽ
+ * @param[in]  *pout    : Ŀ
+ * @param[in]  *format  : ʽַ
+ * @param[in]  args     : б
+ *
+ * @retval     ʽַ(ĿС)
+ ******************************************************************************
+ */
+static int
+fmt_format(fmt_out_t *pout, const char *format, va_list args)
 {
-    register int width, pad;
-    register int pc = 0;
-    char scr[2];
-
-    for (; *format != 0; ++format) {
-        if (*format == '%') {
-            ++format;
-            width = pad = 0;
-            if (*format == '\0') break;
-            if (*format == '%') goto out;
-            if (*format == '-') {
-                ++format;
-                pad = PAD_RIGHT;
-            }
-            while (*format == '0') {
-                ++format;
-                pad |= PAD_ZERO;
-            }
-            for ( ; *format >= '0' && *format <= '9'; ++format) {
-                width *= 10;
-                width += *format - '0';
-            }
-            if( *format == 's' ) {
-                register char *s = (char *)va_arg( args, int );
-                pc += prints (out, s?s:"(null)", width, pad);
-                continue;
-            }
-            if( *format == 'd' ) {
-                pc += printi (out, va_arg( args, int ), 10, 1, width, pad, 'a');
-                continue;
+    const char_t *prun;
+    uint32_t flags;
+    int32_t width;
+    int32_t prec;
+    int32_t lmod;   /* : -2 hh, -1 h, 0 int, 1 l, 2 ll */
+    uint64_t u;
+    long long s;
+    char_t c;
+
+    while (*format != '\0')
+    {
+        /* ַͨ */
+        prun = format;
+        while ((*format != '\0') && (*format != '%'))
+        {
+            format++;
+        }
+        if (format > prun)
+        {
+            out_write(pout, prun, (size_t)(format - prun));
+        }
+        if (*format == '\0')
+        {
+            break;
+        }
+        prun = format++;    /* ָ'%', ޷ʶĸʽ */
+
+        /* ־ */
+        flags = 0u;
+        for (;; format++)
+        {
+            if (*format == '-')      flags |= FL_LEFT;
+            else if (*format == '0') flags |= FL_ZERO;
+            else if (*format == '+') flags |= FL_PLUS;
+            else if (*format == ' ') flags |= FL_SPACE;
+            else if (*format == '#') flags |= FL_ALT;
+            else break;
+        }
+
+        /*  */
+        width = 0;
+        if (*format == '*')
+        {
+            width = va_arg(args, int);
+            if (width < 0)
+            {
+                flags |= FL_LEFT;
+                width = -width;
             }
-            if( *format == 'x' ) {
-                pc += printi (out, va_arg( args, int ), 16, 0, width, pad, 'a');
-                continue;
+            format++;
+        }
+        else
+        {
+            while ((*format >= '0') && (*format <= '9'))
+            {
+                width = (width * 10) + (*format++ - '0');
             }
-            if( *format == 'X' ) {
-                pc += printi (out, va_arg( args, int ), 16, 0, width, pad, 'A');
-                continue;
+        }
+
+        /*  */
+        prec = 0;
+        if (*format == '.')
+        {
+            format++;
+            flags |= FL_PREC;
+            if (*format == '*')
+            {
+                prec = va_arg(args, int);
+                if (prec < 0)
+                {
+                    flags &= ~FL_PREC;
+                    prec = 0;
+                }
+                format++;
             }
-            if( *format == 'u' ) {
-                pc += printi (out, va_arg( args, int ), 10, 0, width, pad, 'a');
-                continue;
+            else
+            {
+                while ((*format >= '0') && (*format <= '9'))
+                {
+                    prec = (prec * 10) + (*format++ - '0');
+                }
             }
-            if( *format == 'c' ) {
+        }
+
+        /*  */
+        lmod = 0;
+        switch (*format)
+        {
+            case 'h':
+                lmod = (*++format == 'h') ? (format++, -2) : -1;
+                break;
+            case 'l':
+                lmod = (*++format == 'l') ? (format++, 2) : 1;
+                break;
+            case 'j':
+            case 'L':
+                lmod = 2;
+                format++;
+                break;
+            case 'z':
+            case 't':
+                lmod = (sizeof(size_t) > sizeof(long)) ? 2 : 1;
+                format++;
+                break;
+            default:
+                break;
+        }
+
+        /* ת */
+        c = *format++;
+        switch (c)
+        {
+            case 'd':
+            case 'i':
+                if (lmod == 2)       s = va_arg(args, long long);
+                else if (lmod == 1)  s = va_arg(args, long);
+                else                 s = va_arg(args, int);
+                if (lmod == -1)      s = (short)s;
+                else if (lmod == -2) s = (signed char)s;
+                u = (s < 0) ? (0u - (uint64_t)s) : (uint64_t)s;
+                fmt_integer(pout, u, (s < 0) ? TRUE : FALSE, 10u,
+                        flags, width, prec);
+                break;
+
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                if (lmod == 2)       u = va_arg(args, unsigned long long);
+                else if (lmod == 1)  u = va_arg(args, unsigned long);
+                else                 u = va_arg(args, unsigned int);
+                if (lmod == -1)      u = (unsigned short)u;
+                else if (lmod == -2) u = (unsigned char)u;
+                if (c == 'X')
+                {
+                    flags |= FL_UPPER;
+                }
+                fmt_integer(pout, u, FALSE,
+                        (c == 'u') ? 10u : (c == 'o') ? 8u : 16u,
+                        flags, width, prec);
+                break;
+
+            case 'p':
+                u = (uint64_t)(size_t)va_arg(args, void *);
+                if (u == 0u)
+                {
+                    out_number(pout, "", "(nil)", 5, 0, 0, NULL, 0, 0,
+                            flags & ~FL_ZERO, width);
+                }
+                else
+                {
+                    fmt_integer(pout, u, FALSE, 16u, flags | FL_ALT,
+                            width, prec);
+                }
+                break;
+
+            case 'c':
+            {
                 /* char are converted to int then pushed on the stack */
-                scr[0] = (char)va_arg( args, int );
-                scr[1] = '\0';
-                pc += prints (out, scr, width, pad);
-                continue;
+                char_t ch = (char_t)va_arg(args, int);
+                out_number(pout, "", &ch, 1, 0, 0, NULL, 0, 0,
+                        flags & ~FL_ZERO, width);
+                break;
             }
-        }
-        else {
-        out:
-            printchar (out, *format);
-            ++pc;
+
+            case 's':
+            {
+                const char_t *pstr = va_arg(args, const char_t *);
+                int32_t len = 0;
+
+                if (pstr == NULL)
+                {
+                    pstr = "(null)";
+                }
+                if (flags & FL_PREC)
+                {
+                    while ((len < prec) && (pstr[len] != '\0'))
+                    {
+                        len++;
+                    }
+                }
+                else
+                {
+                    len = (int32_t)strlen(pstr);
+                }
+                out_number(pout, "", pstr, len, 0, 0, NULL, 0, 0,
+                        flags & ~FL_ZERO, width);
+                break;
+            }
+
+#if (INCLUDE_PRINTF_FLOAT == 1u)
+            case 'f':
+            case 'F':
+                fmt_float(pout, va_arg(args, double),
+                        (c == 'F') ? (flags | FL_UPPER) : flags, width, prec);
+                break;
+#endif
+
+            case '%':
+                out_write(pout, "%", 1);
+                break;
+
+            default:
+                /* ޷ʶĸʽԭ */
+                if (c == '\0')
+                {
+                    format--;
+                }
+                out_write(pout, prun, (size_t)(format - prun));
+                break;
         }
     }
-    if (out) **out = '\0';
-    va_end( args );
-    return pc;
+
+    return (int)pout->count;
 }
 
-int printf(const char *format, ...)
+/**
+ ******************************************************************************
+ * @brief   нʽ
+ * @param[out] *out     : 
+ * @param[in]  size     : С('\0')
+ * @param[in]  *format  : ʽַ
+ * @param[in]  args     : б
+ *
+ * @retval     ʽ('\0'), ڵsizeʾѽض
+ ******************************************************************************
+ */
+int vsnprintf(char *out, size_t size, const char *format, va_list args)
+{
+    fmt_out_t fo = {out, size, 0u, 0u, FALSE};
+
+    (void)fmt_format(&fo, format, args);
+    if (size > 0u)
+    {
+        out[fo.len] = '\0';
+    }
+    return (int)fo.count;
+}
+
+int snprintf(char *out, size_t size, const char *format, ...)
 {
-        va_list args;
+    va_list args;
+    int ret;
+
+    va_start(args, format);
+    ret = vsnprintf(out, size, format, args);
+    va_end(args);
+    return ret;
+}
 
-        va_start( args, format );
-        return print( 0, format, args );
+int vsprintf(char *out, const char *format, va_list args)
+{
+    return vsnprintf(out, (size_t)-1 / 2u, format, args);
 }
 
 int sprintf(char *out, const char *format, ...)
 {
-        va_list args;
+    va_list args;
+    int ret;
+
+    va_start(args, format);
+    ret = vsnprintf(out, (size_t)-1 / 2u, format, args);
+    va_end(args);
+    return ret;
+}
+
+int vprintf(const char *format, va_list args)
+{
+    char_t chunk[FMT_CONSOLE_CHUNK];
+    fmt_out_t fo = {chunk, sizeof(chunk), 0u, 0u, TRUE};
+
+    (void)fmt_format(&fo, format, args);
+    if (fo.len > 0u)
+    {
+        console_write(chunk, fo.len);
+    }
+    return (int)fo.count;
+}
+
+int printf(const char *format, ...)
+{
+    va_list args;
+    int ret;
+
+    va_start(args, format);
+    ret = vprintf(format, args);
+    va_end(args);
+    return ret;
+}
 
-        va_start( args, format );
-        return print( &out, format, args );
+/**
+ ******************************************************************************
+ * @brief   ɽӿ, 
+ * @param[out] **out    : NULL̨, *out(ޱ߽)
+ * @param[in]  *format  : ʽַ
+ * @param[in]  args     : б
+ *
+ * @retval     ʽַ
+ * @note    ´ʹvsnprintf()
+ ******************************************************************************
+ */
+int print(char **out, const char *format, va_list args )
+{
+    if (out == NULL)
+    {
+        return vprintf(format, args);
+    }
+    return vsprintf(*out, format, args);
 }
 /* --------------------------------- End Of File ----------------------------*/
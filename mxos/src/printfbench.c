@@ -0,0 +1,295 @@
+/**
+ ******************************************************************************
+ * @file       printfbench.c
+ * @brief      ʽܲ.
+ * @details    Աvsnprintfɰprint()Լnewlib sniprintfĸʽʱ,
+ *             ͨshellprintfbench, λΪ΢(bsp_timer_get).
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <types.h>
+#include <shell.h>
+#include <intLib.h>
+#include <oshook.h>
+#include <oscfg.h>
+
+#ifndef INCLUDE_PRINTF_BENCH
+# define INCLUDE_PRINTF_BENCH       (0u)    /**< printfܲ */
+#endif
+
+#if (INCLUDE_PRINTF_BENCH == 1u)
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define BENCH_DEFAULT_LOOPS      (1000u)    /**< Ĭѭ */
+#define BENCH_BUF_LEN              (96u)    /**< С */
+
+#define LEGACY_PAD_RIGHT            (1)
+#define LEGACY_PAD_ZERO             (2)
+#define LEGACY_PRINT_BUF_LEN       (12)
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ʽ */
+typedef int (*bench_fmt_t)(char *out, size_t size, const char *format, ...);
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static char the_bench_buf[BENCH_BUF_LEN];
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/* Ϊɰprint()ԭ, д·, ΪԱȻ׼ */
+static void legacy_printchar(char **str, int c)
+{
+    **str = c;
+    ++(*str);
+}
+
+static int legacy_prints(char **out, const char *string, int width, int pad)
+{
+    register int pc = 0, padchar = ' ';
+
+    if (width > 0) {
+        register int len = 0;
+        register const char *ptr;
+        for (ptr = string; *ptr; ++ptr) ++len;
+        if (len >= width) width = 0;
+        else width -= len;
+        if (pad & LEGACY_PAD_ZERO) padchar = '0';
+    }
+    if (!(pad & LEGACY_PAD_RIGHT)) {
+        for ( ; width > 0; --width) {
+            legacy_printchar (out, padchar);
+            ++pc;
+        }
+    }
+    for ( ; *string ; ++string) {
+        legacy_printchar (out, *string);
+        ++pc;
+    }
+    for ( ; width > 0; --width) {
+        legacy_printchar (out, padchar);
+        ++pc;
+    }
+
+    return pc;
+}
+
+static int legacy_printi(char **out, int i, int b, int sg, int width, int pad, int letbase)
+{
+    char print_buf[LEGACY_PRINT_BUF_LEN];
+    register char *s;
+    register int t, neg = 0, pc = 0;
+    register unsigned int u = i;
+
+    if (i == 0) {
+        print_buf[0] = '0';
+        print_buf[1] = '\0';
+        return legacy_prints (out, print_buf, width, pad);
+    }
+
+    if (sg && b == 10 && i < 0) {
+        neg = 1;
+        u = -i;
+    }
+
+    s = print_buf + LEGACY_PRINT_BUF_LEN-1;
+    *s = '\0';
+
+    while (u) {
+        t = u % b;
+        if( t >= 10 )
+            t += letbase - '0' - 10;
+        *--s = t + '0';
+        u /= b;
+    }
+
+    if (neg) {
+        if( width && (pad & LEGACY_PAD_ZERO) ) {
+            legacy_printchar (out, '-');
+            ++pc;
+            --width;
+        }
+        else {
+            *--s = '-';
+        }
+    }
+
+    return pc + legacy_prints (out, s, width, pad);
+}
+
+static int legacy_print(char **out, const char *format, va_list args )
+{
+    register int width, pad;
+    register int pc = 0;
+    char scr[2];
+
+    for (; *format != 0; ++format) {
+        if (*format == '%') {
+            ++format;
+            width = pad = 0;
+            if (*format == '\0') break;
+            if (*format == '%') goto out;
+            if (*format == '-') {
+                ++format;
+                pad = LEGACY_PAD_RIGHT;
+            }
+            while (*format == '0') {
+                ++format;
+                pad |= LEGACY_PAD_ZERO;
+            }
+            for ( ; *format >= '0' && *format <= '9'; ++format) {
+                width *= 10;
+                width += *format - '0';
+            }
+            if( *format == 's' ) {
+                register char *s = (char *)va_arg( args, int );
+                pc += legacy_prints (out, s?s:"(null)", width, pad);
+                continue;
+            }
+            if( *format == 'd' ) {
+                pc += legacy_printi (out, va_arg( args, int ), 10, 1, width, pad, 'a');
+                continue;
+            }
+            if( *format == 'x' ) {
+                pc += legacy_printi (out, va_arg( args, int ), 16, 0, width, pad, 'a');
+                continue;
+            }
+            if( *format == 'X' ) {
+                pc += legacy_printi (out, va_arg( args, int ), 16, 0, width, pad, 'A');
+                continue;
+            }
+            if( *format == 'u' ) {
+                pc += legacy_printi (out, va_arg( args, int ), 10, 0, width, pad, 'a');
+                continue;
+            }
+            if( *format == 'c' ) {
+                scr[0] = (char)va_arg( args, int );
+                scr[1] = '\0';
+                pc += legacy_prints (out, scr, width, pad);
+                continue;
+            }
+        }
+        else {
+        out:
+            legacy_printchar (out, *format);
+            ++pc;
+        }
+    }
+    **out = '\0';
+    return pc;
+}
+
+/**
+ ******************************************************************************
+ * @brief      ɰprint()snprintfʽװ(size, ʵһ)
+ ******************************************************************************
+ */
+static int
+legacy_snprintf(char *out, size_t size, const char *format, ...)
+{
+    int len;
+    va_list args;
+
+    (void)size;
+    va_start(args, format);
+    len = legacy_print(&out, format, args);
+    va_end(args);
+
+    return len;
+}
+
+/**
+ ******************************************************************************
+ * @brief      һʽʱ
+ * @param[in]  pfmt  : ⺯
+ * @param[in]  loops : ѭ
+ *
+ * @retval     ܺʱ(us)
+ ******************************************************************************
+ */
+static uint32_t
+bench_run(bench_fmt_t pfmt, uint32_t loops)
+{
+    uint32_t i;
+    uint32_t start = bsp_timer_get();
+
+    for (i = 0u; i < loops; i++)
+    {
+        (void)pfmt(the_bench_buf, sizeof(the_bench_buf),
+                "%d %u %x %08X %s %c", -(int)i, i * 7u, i, i * 13u,
+                "logmsg", 'z');
+    }
+
+    return bsp_timer_get() - start;
+}
+
+/**
+ ******************************************************************************
+ * @brief      ӡһвԽ
+ ******************************************************************************
+ */
+static void
+bench_report(const char *pname, uint32_t us, uint32_t loops)
+{
+    printf("%-12s %10u us %8u ns/call\n", pname, us,
+            (uint32_t)(((uint64_t)us * 1000u) / loops));
+}
+
+/**
+ ******************************************************************************
+ * @brief      printfbench: Ƚϸʽʵֵĺʱ
+ * @param[in]  argv[1] : ѭ(ѡ)
+ *
+ * @retval     0
+ ******************************************************************************
+ */
+uint32_t
+do_printfbench(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    uint32_t loops = BENCH_DEFAULT_LOOPS;
+    uint32_t us;
+
+    (void)cmdtp;
+    if (argc > 1u)
+    {
+        loops = (uint32_t)strtoul((const char *)argv[1], NULL, 0);
+    }
+    if (loops == 0u)
+    {
+        loops = BENCH_DEFAULT_LOOPS;
+    }
+
+    printf("printfbench: %u loops, \"%%d %%u %%x %%08X %%s %%c\"\n", loops);
+
+    us = bench_run(legacy_snprintf, loops);
+    bench_report("print(old)", us, loops);
+
+    us = bench_run(snprintf, loops);
+    bench_report("vsnprintf", us, loops);
+
+#if defined(_NEWLIB_VERSION)
+    /* snprintfѱprintf.c滻, ʹnewlibͰ汾Ϊ */
+    us = bench_run(sniprintf, loops);
+    bench_report("newlib", us, loops);
+#endif
+
+    return 0;
+}
+
+SHELL_CMD(printfbench, 2, do_printfbench, "printfbench [loops]\r\n");
+
+#endif /* INCLUDE_PRINTF_BENCH */
+/*-----------------------------printfbench.c---------------------------------*/
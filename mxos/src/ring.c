@@ -89,6 +89,7 @@ uint16_t
 ring_write(struct ring_buf *ring, const uint8_t *buffer, uint16_t len)
 {
     uint16_t wr_len;
+    uint32_t key;
     uint16_t partial;
 
     wr_len = ring->max_len - ring->len;
@@ -113,9 +114,9 @@ ring_write(struct ring_buf *ring, const uint8_t *buffer, uint16_t len)
         ring->offset_write += wr_len;
     }
 
-    intLock();
+    key = intLock();
     ring->len += wr_len;
-    intUnlock();
+    intUnlock(key);
 
     return wr_len;
 }
@@ -137,6 +138,7 @@ uint16_t
 ring_write_force(struct ring_buf *ring, const uint8_t *buffer, uint16_t len)
 {
     uint16_t wr_len = len;
+    uint32_t key;
     uint16_t partial;
 
     if (len > ring->max_len)
@@ -157,9 +159,9 @@ ring_write_force(struct ring_buf *ring, const uint8_t *buffer, uint16_t len)
         ring->offset_write += wr_len;
     }
 
-    intLock();
+    key = intLock();
     ring->len += wr_len;
-    intUnlock();
+    intUnlock(key);
 
     return wr_len;
 }
@@ -181,6 +183,7 @@ uint16_t
 ring_read(struct ring_buf *ring, uint8_t *buffer, uint16_t len)
 {
     uint16_t wr_len;
+    uint32_t key;
 
     wr_len = (ring->len < len) ? ring->len : len;
     if ((ring->offset_read + wr_len) > ring->max_len)
@@ -196,9 +199,9 @@ ring_read(struct ring_buf *ring, uint8_t *buffer, uint16_t len)
         memcpy(buffer, &ring->buf[ring->offset_read], wr_len);
         ring->offset_read += wr_len;
     }
-    intLock();
+    key = intLock();
     ring->len -= wr_len;
-    intUnlock();
+    intUnlock(key);
 
     return wr_len;
 }
@@ -281,6 +284,7 @@ uint16_t
 ring_dumb_read(struct ring_buf *ring, uint16_t len)
 {
     uint16_t result;
+    uint32_t key;
 
     result = (ring->len < len) ? ring->len : len;
     if ((ring->offset_read + result) > ring->max_len)
@@ -291,9 +295,9 @@ ring_dumb_read(struct ring_buf *ring, uint16_t len)
     { //
         ring->offset_read += result;
     }
-    intLock();
+    key = intLock();
     ring->len -= result;
-    intUnlock();
+    intUnlock(key);
     return result;
 }
 
@@ -315,6 +319,7 @@ uint16_t
 ring_recede_read(struct ring_buf *ring, uint16_t len)
 {
     uint16_t result;
+    uint32_t key;
 
     if ((ring->max_len - ring->len) > len) //гȴ˻صĳ
     {
@@ -333,9 +338,9 @@ ring_recede_read(struct ring_buf *ring, uint16_t len)
     { //
         ring->offset_read -= result;
     }
-    intLock();
+    key = intLock();
     ring->len += result;
-    intUnlock();
+    intUnlock(key);
 
     return result;
 }
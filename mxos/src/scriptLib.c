@@ -0,0 +1,809 @@
+/**
+ ******************************************************************************
+ * @file      scriptLib.c
+ * @brief     ʵshellű, FatFsļжȡִ.
+ * @details   űС뻺, ÿչ󽻸shell_exec,
+ *            ״̬malloc, ռõĶջ. ﷨:
+ *              # ע          к'#'ͷк
+ *              set NAME VALUE  ñ, $NAME${NAME}
+ *              $? $0..$9 $$    һֵ, űͲ, ַ'$'
+ *              if [!] CMD      CMD0('!'ʱ0)ִеelseendif
+ *              else / endif    ǶSCRIPT_MAX_NEST
+ *              echo TEXT       һ
+ *              exit [N]        ű, N, ȱʡΪ$?
+ *            аshellִ, ';'ָ.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <types.h>
+#include <taskLib.h>
+#include <dmnLib.h>
+#include <shell.h>
+#include <oshook.h>
+#include <scriptLib.h>
+#include <ff.h>
+#include <oscfg.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef SCRIPT_SECTOR_SIZE
+# define SCRIPT_SECTOR_SIZE       (_MAX_SS) /**< ÿf_readĳ */
+#endif
+
+#ifndef CFG_CBSIZE
+# define CFG_CBSIZE                (50u)    /**< ֽ, ͬshell.c */
+#endif
+
+#ifndef SCRIPT_LINE_SIZE
+# define SCRIPT_LINE_SIZE     (CFG_CBSIZE)  /**< ű(չ)󳤶 */
+#endif
+
+#ifndef SCRIPT_MAX_VARS
+# define SCRIPT_MAX_VARS            (8u)    /**< ÿűı */
+#endif
+
+#ifndef SCRIPT_MAX_NEST
+# define SCRIPT_MAX_NEST            (4u)    /**< ifǶײ */
+#endif
+
+#ifndef SCRIPT_MAX_DEPTH
+# define SCRIPT_MAX_DEPTH           (2u)    /**< űsourceűĲ */
+#endif
+
+#ifndef SCRIPT_MAX_TASKS
+# define SCRIPT_MAX_TASKS           (4u)    /**< ͬʱִнű */
+#endif
+
+/* չнrun_commandִ, 䲻CFG_CBSIZEϳȵ */
+#if (SCRIPT_LINE_SIZE > CFG_CBSIZE)
+# error "Please set SCRIPT_LINE_SIZE <= CFG_CBSIZE"
+#endif
+
+#define SCRIPT_NAME_LEN            (12u)    /**< 󳤶('\0') */
+#define SCRIPT_VALUE_LEN           (32u)    /**< ֵ󳤶('\0') */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ű */
+typedef struct
+{
+    char_t name[SCRIPT_NAME_LEN];
+    char_t value[SCRIPT_VALUE_LEN];
+} script_var_t;
+
+/** if״̬ */
+typedef struct
+{
+    bool_e parent;                      /**< Ƿִ */
+    bool_e cond;                        /**< Ƿ */
+    bool_e in_else;                     /**< Ƿѵelse֧ */
+} script_if_t;
+
+/** űִ */
+typedef struct script_ctx
+{
+    struct script_ctx *pparent;         /**< sourceűĽű, ΪNULL */
+    uint32_t depth;                     /**< sourceǶײ, Ϊ1 */
+    FIL fil;                            /**< űļ */
+    uint32_t pos;                       /**< sectеĶλ */
+    uint32_t len;                       /**< sectеЧ */
+    uint32_t lineno;                    /**< ǰк */
+    uint32_t flags;                     /**< SCRIPT_F_xxx */
+    const char_t *ppath;                /**< $0 */
+    uint32_t argc;                      /**< $1..$9ĸ */
+    const char_t **argv;
+    int32_t rc;                         /**< $? */
+    uint32_t nest;                      /**< ǰif */
+    script_if_t ifs[SCRIPT_MAX_NEST];
+    script_var_t vars[SCRIPT_MAX_VARS];
+    char_t line[SCRIPT_LINE_SIZE];      /**<  */
+    char_t cmd[SCRIPT_LINE_SIZE];       /**< չ */
+    uint8_t sect[SCRIPT_SECTOR_SIZE];   /**<  */
+} script_ctx_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/** ǰִеĽű, sourceĽűͨҵ */
+static struct
+{
+    TASK_ID tid;
+    script_ctx_t *pctx;
+} the_script_tasks[SCRIPT_MAX_TASKS];
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ǼǵǰִеĽű, űpctx->pparentס
+ * @param[in]  pctx : ű
+ *
+ * @retval     OK    : ɹ, pctx->depthΪǶײ
+ * @retval     ERROR : ͬʱִнű
+ ******************************************************************************
+ */
+static status_t
+script_enter(script_ctx_t *pctx)
+{
+    TASK_ID tid = taskIdSelf();
+    int32_t free_slot = -1;
+    uint32_t i;
+
+    taskLock();
+    for (i = 0u; i < SCRIPT_MAX_TASKS; i++)
+    {
+        if (the_script_tasks[i].tid == tid)
+        {
+            pctx->pparent = the_script_tasks[i].pctx;
+            pctx->depth = pctx->pparent->depth + 1u;
+            the_script_tasks[i].pctx = pctx;
+            taskUnlock();
+            return OK;
+        }
+        if ((free_slot < 0) && (the_script_tasks[i].tid == NULL))
+        {
+            free_slot = (int32_t)i;
+        }
+    }
+    if (free_slot >= 0)
+    {
+        pctx->pparent = NULL;
+        pctx->depth = 1u;
+        the_script_tasks[free_slot].pctx = pctx;
+        the_script_tasks[free_slot].tid = tid;
+    }
+    taskUnlock();
+
+    return (free_slot >= 0) ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ű, ָǰű
+ * @param[in]  pctx : ű
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+script_leave(script_ctx_t *pctx)
+{
+    TASK_ID tid = taskIdSelf();
+    uint32_t i;
+
+    taskLock();
+    for (i = 0u; i < SCRIPT_MAX_TASKS; i++)
+    {
+        if (the_script_tasks[i].tid == tid)
+        {
+            the_script_tasks[i].pctx = pctx->pparent;
+            if (pctx->pparent == NULL)
+            {
+                the_script_tasks[i].tid = NULL;
+            }
+            break;
+        }
+    }
+    taskUnlock();
+}
+
+/**
+ ******************************************************************************
+ * @brief   һ, ʱСf_read
+ * @param[in]  pctx : ű
+ *
+ * @retval     >=0  : г, дpctx->line
+ * @retval     -1   : ļ
+ * @retval     -2   : ̫
+ ******************************************************************************
+ */
+static int32_t
+script_getline(script_ctx_t *pctx)
+{
+    uint32_t n = 0u;
+    bool_e got = FALSE;
+    bool_e over = FALSE;
+    UINT br = 0u;
+    char_t c;
+
+    while (TRUE)
+    {
+        if (pctx->pos == pctx->len)
+        {
+            pctx->pos = 0u;
+            pctx->len = 0u;
+            if ((f_read(&pctx->fil, pctx->sect, SCRIPT_SECTOR_SIZE, &br)
+                    != FR_OK) || (br == 0u))
+            {
+                if (got == FALSE)
+                {
+                    return -1;
+                }
+                break;      /* һûлз */
+            }
+            pctx->len = br;
+        }
+        got = TRUE;
+        c = (char_t)pctx->sect[pctx->pos++];
+        if (c == '\n')
+        {
+            break;
+        }
+        if (c == '\r')
+        {
+            continue;
+        }
+        if (n < (SCRIPT_LINE_SIZE - 1u))
+        {
+            pctx->line[n++] = c;
+        }
+        else
+        {
+            over = TRUE;
+        }
+    }
+    pctx->line[n] = '\0';
+    pctx->lineno++;
+
+    return (over == TRUE) ? -2 : (int32_t)n;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ǷΪַ
+ ******************************************************************************
+ */
+static bool_e
+script_isname(char_t c)
+{
+    return (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'))
+            || ((c >= '0') && (c <= '9')) || (c == '_')) ? TRUE : FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ұ
+ * @param[in]  pctx  : ű
+ * @param[in]  pname : 
+ *
+ * @retval     , ڷNULL
+ ******************************************************************************
+ */
+static script_var_t *
+script_var_find(script_ctx_t *pctx, const char_t *pname)
+{
+    uint32_t i;
+
+    for (i = 0u; i < SCRIPT_MAX_VARS; i++)
+    {
+        if ((pctx->vars[i].name[0] != '\0')
+                && (strcmp(pctx->vars[i].name, pname) == 0))
+        {
+            return &pctx->vars[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ñ
+ * @param[in]  pctx   : ű
+ * @param[in]  pname  : 
+ * @param[in]  pvalue : ֵ
+ *
+ * @retval     OK    : ɹ
+ * @retval     ERROR : ַǷ̫
+ ******************************************************************************
+ */
+static status_t
+script_var_set(script_ctx_t *pctx, const char_t *pname, const char_t *pvalue)
+{
+    script_var_t *pvar;
+    const char_t *p;
+    uint32_t i;
+
+    for (p = pname; *p != '\0'; p++)
+    {
+        if (script_isname(*p) == FALSE)
+        {
+            return ERROR;
+        }
+    }
+    if ((p == pname) || ((uint32_t)(p - pname) >= SCRIPT_NAME_LEN)
+            || (strlen(pvalue) >= SCRIPT_VALUE_LEN))
+    {
+        return ERROR;
+    }
+
+    pvar = script_var_find(pctx, pname);
+    for (i = 0u; (pvar == NULL) && (i < SCRIPT_MAX_VARS); i++)
+    {
+        if (pctx->vars[i].name[0] == '\0')
+        {
+            pvar = &pctx->vars[i];
+            strcpy(pvar->name, pname);
+        }
+    }
+    if (pvar == NULL)
+    {
+        return ERROR;
+    }
+    strcpy(pvar->value, pvalue);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   չеıõpctx->cmd
+ * @param[in]  pctx : ű
+ * @param[in]  psrc : Դ
+ *
+ * @retval     0    : ɹ
+ * @retval     -1   : ${δպ
+ * @retval     -2   : չ̫
+ ******************************************************************************
+ */
+static int32_t
+script_expand(script_ctx_t *pctx, const char_t *psrc)
+{
+    char_t name[SCRIPT_NAME_LEN];
+    char_t num[12];
+    const char_t *pval;
+    script_var_t *pvar;
+    uint32_t n = 0u;
+    uint32_t len;
+    uint32_t idx;
+    bool_e brace;
+
+    while (*psrc != '\0')
+    {
+        if (*psrc != '$')
+        {
+            if ((n + 1u) >= SCRIPT_LINE_SIZE)
+            {
+                return -2;
+            }
+            pctx->cmd[n++] = *psrc++;
+            continue;
+        }
+
+        psrc++;
+        if (*psrc == '$')
+        {
+            pval = "$";
+            psrc++;
+        }
+        else if (*psrc == '?')
+        {
+            (void)snprintf(num, sizeof(num), "%d", pctx->rc);
+            pval = num;
+            psrc++;
+        }
+        else if ((*psrc >= '0') && (*psrc <= '9'))
+        {
+            idx = (uint32_t)(*psrc++ - '0');
+            if (idx == 0u)
+            {
+                pval = pctx->ppath;
+            }
+            else
+            {
+                pval = (idx <= pctx->argc) ? pctx->argv[idx - 1u] : "";
+            }
+        }
+        else
+        {
+            brace = (*psrc == '{') ? TRUE : FALSE;
+            if (brace == TRUE)
+            {
+                psrc++;
+            }
+            for (len = 0u; script_isname(*psrc) == TRUE; psrc++)
+            {
+                if (len < (SCRIPT_NAME_LEN - 1u))
+                {
+                    name[len++] = *psrc;
+                }
+            }
+            name[len] = '\0';
+            if (brace == TRUE)
+            {
+                if (*psrc != '}')
+                {
+                    return -1;
+                }
+                psrc++;
+            }
+            if (len == 0u)
+            {
+                pval = "$";     /* '$'ԭ */
+            }
+            else
+            {
+                pvar = script_var_find(pctx, name);
+                pval = (pvar != NULL) ? pvar->value : "";
+            }
+        }
+
+        len = strlen(pval);
+        if ((n + len) >= SCRIPT_LINE_SIZE)
+        {
+            return -2;
+        }
+        memcpy(&pctx->cmd[n], pval, len);
+        n += len;
+    }
+    pctx->cmd[n] = '\0';
+
+    return 0;
+}
+
+/**
+ ******************************************************************************
+ * @brief   жǷָؼֿͷ
+ * @param[in]  pline : (ǰհ)
+ * @param[in]  pword : ؼ
+ *
+ * @retval     ؼ֮Ĳ(հ), ƥ䷵NULL
+ ******************************************************************************
+ */
+static char_t *
+script_word(char_t *pline, const char_t *pword)
+{
+    uint32_t len = strlen(pword);
+
+    if ((strncmp(pline, pword, len) != 0)
+            || ((pline[len] != '\0') && (pline[len] != ' ')
+                    && (pline[len] != '\t')))
+    {
+        return NULL;
+    }
+    pline += len;
+    while ((*pline == ' ') || (*pline == '\t'))
+    {
+        pline++;
+    }
+    return pline;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ǰǷִз֧
+ ******************************************************************************
+ */
+static bool_e
+script_active(const script_ctx_t *pctx)
+{
+    const script_if_t *pif;
+
+    if (pctx->nest == 0u)
+    {
+        return TRUE;
+    }
+    pif = &pctx->ifs[pctx->nest - 1u];
+    return ((pif->parent == TRUE) && (pif->cond != pif->in_else))
+            ? TRUE : FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ִһshell, ѡԺͼʱ
+ * @param[in]  pctx : ű
+ * @param[in]  pcmd : 
+ *
+ * @retval     ֵ
+ ******************************************************************************
+ */
+static int32_t
+script_exec(script_ctx_t *pctx, const char_t *pcmd)
+{
+    uint32_t start;
+    int32_t rc;
+
+    if ((pctx->flags & SCRIPT_F_ECHO) != 0u)
+    {
+        printf("+ %s\n", pcmd);
+    }
+    start = bsp_timer_get();
+    rc = shell_exec(pcmd);
+    if ((pctx->flags & SCRIPT_F_TIME) != 0u)
+    {
+        start = bsp_timer_get() - start;
+        printf("[%s:%u] rc=%d %u.%03u ms\n", pctx->ppath, pctx->lineno, rc,
+                start / 1000u, start % 1000u);
+    }
+    (void)dmn_sign_self();      /* űιỰĹ */
+    pctx->rc = rc;
+
+    return rc;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ﷨
+ ******************************************************************************
+ */
+static int32_t
+script_syntax(const script_ctx_t *pctx, const char_t *pwhat)
+{
+    printf("%s:%u: %s\n", pctx->ppath, pctx->lineno, pwhat);
+    return SCRIPT_ERR_SYNTAX;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ִнű
+ * @param[in]  pctx : ű
+ *
+ * @retval     űֵ
+ ******************************************************************************
+ */
+static int32_t
+script_loop(script_ctx_t *pctx)
+{
+    script_if_t *pif;
+    char_t *p;
+    char_t *parg;
+    char_t *pval;
+    bool_e neg;
+    int32_t len;
+
+    while ((len = script_getline(pctx)) != -1)
+    {
+        if (len < 0)
+        {
+            return script_syntax(pctx, "line too long");
+        }
+        for (p = pctx->line; (*p == ' ') || (*p == '\t'); p++)
+        {
+        }
+        if ((*p == '\0') || (*p == '#'))
+        {
+            continue;
+        }
+
+        /* ̿ڲִеķ֧ҲҪٲ */
+        if ((parg = script_word(p, "if")) != NULL)
+        {
+            if (pctx->nest >= SCRIPT_MAX_NEST)
+            {
+                return script_syntax(pctx, "if nested too deep");
+            }
+            pif = &pctx->ifs[pctx->nest];
+            pif->parent = script_active(pctx);
+            pif->cond = FALSE;
+            pif->in_else = FALSE;
+            pctx->nest++;
+            if (pif->parent == FALSE)
+            {
+                continue;
+            }
+            neg = (script_word(parg, "!") != NULL) ? TRUE : FALSE;
+            if (neg == TRUE)
+            {
+                parg = script_word(parg, "!");
+            }
+            if ((len = script_expand(pctx, parg)) != 0)
+            {
+                return script_syntax(pctx, (len == -2)
+                        ? "line too long" : "bad variable");
+            }
+            pif->cond = ((script_exec(pctx, pctx->cmd) == 0) != neg)
+                    ? TRUE : FALSE;
+            continue;
+        }
+        if (script_word(p, "else") != NULL)
+        {
+            if ((pctx->nest == 0u)
+                    || (pctx->ifs[pctx->nest - 1u].in_else == TRUE))
+            {
+                return script_syntax(pctx, "else without if");
+            }
+            pctx->ifs[pctx->nest - 1u].in_else = TRUE;
+            continue;
+        }
+        if (script_word(p, "endif") != NULL)
+        {
+            if (pctx->nest == 0u)
+            {
+                return script_syntax(pctx, "endif without if");
+            }
+            pctx->nest--;
+            continue;
+        }
+        if (script_active(pctx) == FALSE)
+        {
+            continue;
+        }
+
+        if ((len = script_expand(pctx, p)) != 0)
+        {
+            return script_syntax(pctx, (len == -2)
+                    ? "line too long" : "bad variable");
+        }
+        p = pctx->cmd;
+        if ((parg = script_word(p, "set")) != NULL)
+        {
+            for (pval = parg; (*pval != '\0') && (*pval != ' ')
+                    && (*pval != '\t'); pval++)
+            {
+            }
+            if (*pval != '\0')
+            {
+                *pval++ = '\0';
+                while ((*pval == ' ') || (*pval == '\t'))
+                {
+                    pval++;
+                }
+            }
+            if (script_var_set(pctx, parg, pval) != OK)
+            {
+                return script_syntax(pctx, "bad set");
+            }
+        }
+        else if ((parg = script_word(p, "echo")) != NULL)
+        {
+            printf("%s\n", parg);
+        }
+        else if ((parg = script_word(p, "exit")) != NULL)
+        {
+            return (*parg == '\0') ? pctx->rc : (int32_t)strtol(parg, NULL, 0);
+        }
+        else if ((script_exec(pctx, p) != 0)
+                && ((pctx->flags & SCRIPT_F_ERREXIT) != 0u))
+        {
+            printf("%s:%u: '%s' failed (%d)\n", pctx->ppath, pctx->lineno,
+                    p, pctx->rc);
+            return pctx->rc;
+        }
+    }
+
+    if (pctx->nest != 0u)
+    {
+        return script_syntax(pctx, "missing endif");
+    }
+    return pctx->rc;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ִнűļ
+ * @param[in]  ppath : ű·, "0:/TEST.SH"
+ * @param[in]  argc  : ű, Ӧ$1..$9
+ * @param[in]  argv  : ű
+ * @param[in]  flags : SCRIPT_F_xxx
+ *
+ * @retval     0               : ɹ
+ * @retval     SCRIPT_ERR_OPEN : ļ򲻿(űʱݴ˾Ĭ)
+ * @retval                 : exitֵһķֵ﷨
+ *
+ * @details ڵִ, űеsourceű, ÿ
+ *          ǶײSCRIPT_MAX_DEPTH, (Ự)Ӱ.
+ ******************************************************************************
+ */
+int32_t
+script_run(const char_t *ppath, uint32_t argc, const char_t *argv[],
+        uint32_t flags)
+{
+    script_ctx_t *pctx;
+    uint32_t start;
+    int32_t rc;
+
+    if (ppath == NULL)
+    {
+        return SCRIPT_ERR_OPEN;
+    }
+
+    pctx = malloc(sizeof(script_ctx_t));
+    if (pctx == NULL)
+    {
+        printf("%s: no memory\n", ppath);
+        return -1;
+    }
+    memset(pctx, 0, sizeof(script_ctx_t));
+
+    if (script_enter(pctx) != OK)
+    {
+        free(pctx);
+        printf("%s: too many tasks running scripts\n", ppath);
+        return SCRIPT_ERR_SYNTAX;
+    }
+    if (pctx->depth > SCRIPT_MAX_DEPTH)
+    {
+        script_leave(pctx);
+        free(pctx);
+        printf("%s: scripts nested too deep\n", ppath);
+        return SCRIPT_ERR_SYNTAX;
+    }
+
+    if (f_open(&pctx->fil, ppath, FA_READ | FA_OPEN_EXISTING) != FR_OK)
+    {
+        script_leave(pctx);
+        free(pctx);
+        return SCRIPT_ERR_OPEN;
+    }
+    pctx->flags = flags;
+    pctx->ppath = ppath;
+    pctx->argc = (argv == NULL) ? 0u : argc;
+    pctx->argv = argv;
+
+    start = bsp_timer_get();
+    rc = script_loop(pctx);
+    if ((flags & SCRIPT_F_TIME) != 0u)
+    {
+        start = bsp_timer_get() - start;
+        printf("%s: rc=%d, %u lines, %u.%03u ms\n", ppath, rc, pctx->lineno,
+                start / 1000u, start % 1000u);
+    }
+
+    (void)f_close(&pctx->fil);
+    script_leave(pctx);
+    free(pctx);
+
+    return rc;
+}
+
+/*SHELL CMD FOR SCRIPT*/
+uint32_t
+do_source(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    uint32_t flags = 0u;
+    uint32_t i;
+    const uint8_t *p;
+    int32_t rc;
+
+    for (i = 1u; (i < argc) && (argv[i][0] == '-'); i++)
+    {
+        for (p = &argv[i][1]; *p != '\0'; p++)
+        {
+            switch (*p)
+            {
+            case 'x':
+                flags |= SCRIPT_F_ECHO;
+                break;
+            case 't':
+                flags |= SCRIPT_F_TIME;
+                break;
+            case 'e':
+                flags |= SCRIPT_F_ERREXIT;
+                break;
+            default:
+                printf("Usage:\n%s", cmdtp->usage);
+                return 1;
+            }
+        }
+    }
+    if (i >= argc)
+    {
+        printf("Usage:\n%s", cmdtp->usage);
+        return 1;
+    }
+
+    rc = script_run((const char_t *)argv[i], argc - i - 1u,
+            (const char_t **)&argv[i + 1u], flags);
+    if (rc == SCRIPT_ERR_OPEN)
+    {
+        printf("can't open %s\n", argv[i]);
+    }
+    return (uint32_t)rc;
+}
+
+SHELL_CMD(source, 8, do_source,
+        "source [-x echo] [-t time] [-e stop on error] file [args]\r\n");
+SHELL_CMD(run, 8, do_source,
+        "run [-xte] file [args] -- same as source\r\n");
+
+/*--------------------------------scriptLib.c--------------------------------*/
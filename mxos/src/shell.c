@@ -8,14 +8,18 @@
  ******************************************************************************
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <shell.h>
 #include <debug.h>
 #include <taskLib.h>
 #include <dmnLib.h>
 #include <devLib.h>
+#include <ttyLib.h>
+#include <scriptLib.h>
 #include <oscfg.h>
 #include <logLib.h>
+#include <maths.h>
 
 /*-----------------------------------------------------------------------------
  Section: Constant Definitions
@@ -35,8 +39,23 @@
 #ifndef CFG_CBSIZE
 # define CFG_CBSIZE                (50u)    /**< ֽ */
 #endif
+
+#ifndef SHELL_IDLE_TICKS
+# define SHELL_IDLE_TICKS     (TICKS_PER_SECOND)/**< ʱĵȴʱ(ι) */
+#endif
 #define SHELL_PRINTF        printf          /**< ַ */
 
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** Ự״̬, λڻỰĶջ */
+typedef struct
+{
+    shell_io_t *pio;                /**< Ự */
+    DMN_ID dmnid;                   /**< ỰιID */
+    uint8_t buf[CFG_CBSIZE];        /**< л */
+} shell_sess_t;
+
 /*-----------------------------------------------------------------------------
  Section: Global Variables
  ----------------------------------------------------------------------------*/
@@ -47,17 +66,16 @@ extern int32_t _the_console_fd;
 /*-----------------------------------------------------------------------------
  Section: Local Variables
  ----------------------------------------------------------------------------*/
-static uint8_t console_buffer[CFG_CBSIZE]; /* console I/O buffer   */
 static const char_t erase_seq[] = "\b \b";
 static const char_t const *prompt = "~#";
-static cmd_tbl_t *pmatch_cmd = NULL;
+static cmd_tbl_t **the_cmd_index = NULL;   /**<  */
+static uint32_t the_cmd_num = 0u;          /**< the_cmd_indexе */
 static TASK_ID shellTaskId = 0;
-static DMN_ID the_dmnid = NULL;
 
 /*-----------------------------------------------------------------------------
  Section: static Function Prototypes
  ----------------------------------------------------------------------------*/
-static bool_e readline(void);
+static int32_t readline(shell_sess_t *ps);
 static cmd_tbl_t *find_cmd(const char *cmd);
 static int parse_line(char_t *line, char_t *argv[]);
 static int run_command(char_t *cmd);
@@ -65,6 +83,103 @@ static int run_command(char_t *cmd);
 /*-----------------------------------------------------------------------------
  Section: Function Definitions
  ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief      ֱȽ, qsortʹ
+ ******************************************************************************
+ */
+static int
+cmd_compare(const void *pa, const void *pb)
+{
+    return strcmp((*(cmd_tbl_t * const *)pa)->name,
+            (*(cmd_tbl_t * const *)pb)->name);
+}
+
+/**
+ ******************************************************************************
+ * @brief      
+ * @param[in]  None
+ *
+ * @retval     OK    : ɹ
+ * @retval     ERROR : ڴ治
+ *
+ * @details    .shell_cmdеλflash˳Ӿ, 
+ *             shell_initʱһָ, ֮ҺͲȫΪ.
+ ******************************************************************************
+ */
+static status_t
+cmd_index_init(void)
+{
+    cmd_tbl_t *cmdtp;
+    uint32_t n = (uint32_t)(&__shell_cmd_end - &__shell_cmd_start);
+
+    the_cmd_index = malloc((n + 1u) * sizeof(cmd_tbl_t *));
+    if (the_cmd_index == NULL)
+    {
+        return ERROR;
+    }
+    for (cmdtp = &__shell_cmd_start; cmdtp != &__shell_cmd_end; cmdtp++)
+    {
+        if (cmdtp->name != NULL)
+        {
+            the_cmd_index[the_cmd_num++] = cmdtp;
+        }
+    }
+    qsort(the_cmd_index, the_cmd_num, sizeof(cmd_tbl_t *), cmd_compare);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief      ֲָǰ׺ͷ
+ * @param[in]  pkey   : ǰ׺
+ * @param[in]  len    : ǰ׺
+ * @param[out] pfirst : һƥthe_cmd_indexе±
+ *
+ * @retval     ƥ, ƥthe_cmd_index
+ ******************************************************************************
+ */
+static uint32_t
+cmd_range(const char_t *pkey, uint32_t len, uint32_t *pfirst)
+{
+    uint32_t lo = 0u;
+    uint32_t hi = the_cmd_num;
+    uint32_t mid;
+    uint32_t first;
+
+    /* ֽȡǰlenַԱ, ƥһ */
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2u;
+        if (strncmp(the_cmd_index[mid]->name, pkey, len) < 0)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    first = lo;
+    hi = the_cmd_num;
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2u;
+        if (strncmp(the_cmd_index[mid]->name, pkey, len) <= 0)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    *pfirst = first;
+
+    return lo - first;
+}
+
 /**
  ******************************************************************************
  * @brief      find command table entry for a command
@@ -72,7 +187,7 @@ static int run_command(char_t *cmd);
  * @param[out] None
  * @retval     None
  *
- * @details
+ * @details    ȫƥΨһǰ׺ƥʱ, ֲ
  *
  * @note
  ******************************************************************************
@@ -80,58 +195,57 @@ static int run_command(char_t *cmd);
 static cmd_tbl_t *
 find_cmd(const char_t *cmd)
 {
-    cmd_tbl_t *cmdtp;
-    cmd_tbl_t *cmdtp_temp = &__shell_cmd_start; /*Init value */
     const char_t *p;
-    int32_t len;
-    int32_t n_found = 0;
+    uint32_t len;
+    uint32_t first;
+    uint32_t num;
 
     /*
      * Some commands allow length modifiers (like "cp.b");
      * compare command name only until first dot.
      */
-    len = ((p = strchr(cmd, '.')) == NULL) ? strlen(cmd) : (p - cmd);
+    p = strchr(cmd, '.');
+    len = (p == NULL) ? (uint32_t)strlen(cmd) : (uint32_t)(p - cmd);
 
-    for (cmdtp = &__shell_cmd_start; cmdtp != &__shell_cmd_end; cmdtp++)
+    num = cmd_range(cmd, len, &first);
+    if (num == 0u)
     {
-        if (strncmp(cmd, (char *) cmdtp->name, len) == 0)
-        {
-            if (len == strlen(cmdtp->name))
-            {
-                return cmdtp; /* full match */
-            }
-
-            cmdtp_temp = cmdtp; /* abbreviated command ? */
-            n_found++;
-        }
+        return NULL; /* not found */
     }
-    if (n_found == 1)
+
+    /* ϶̵ǰ, ȫƥֻǵһ */
+    if ((num == 1u) || (strlen(the_cmd_index[first]->name) == len))
     {
-        /* exactly one match */
-        return cmdtp_temp;
+        return the_cmd_index[first];
     }
 
-    return NULL; /* not found or ambiguous command */
+    return NULL; /* ambiguous command */
 }
 
 /**
  ******************************************************************************
- * @brief      ƥ
- * @param[in]  char_t *buf
- * @param[in]  int32_t len
- * @retval     None
+ * @brief      TABȫ
+ * @param[in]  char_t *buf  : л, '\0'
+ * @param[in]  uint32_t len : г
+ * @retval     >=0: ȫгƥг, ػʾ
+ * @retval     -1 : в, ȫ
+ * @retval     -2 : ûƥ
  *
- * @details
+ * @details    ΨһƥʱȫΪ" "; ƥʱȫǵĹǰ׺,
+ *             ޿ɲȫַʱгƥ.
  *
  * @note
  ******************************************************************************
  */
 static int32_t
-match_cmd(char_t *buf, int32_t len)
+match_cmd(char_t *buf, uint32_t len)
 {
-    cmd_tbl_t *pcmd = NULL;
-    int32_t i = 0;
-    uint8_t flag = 0u;
+    const char_t *pfirst;
+    const char_t *plast;
+    uint32_t first;
+    uint32_t num;
+    uint32_t common;
+    uint32_t i;
 
     for (i = 0; i < len; i++)
     {
@@ -141,74 +255,133 @@ match_cmd(char_t *buf, int32_t len)
         }
     }
 
-    (pmatch_cmd != NULL) ? (pcmd = pmatch_cmd + 1)
-            : (pmatch_cmd = pcmd = &__shell_cmd_start);
+    num = cmd_range(buf, len, &first);
+    if (num == 0u)
+    {
+        return -2;
+    }
 
-    do {
-        if (pcmd >= &__shell_cmd_end)
-        {
-            pcmd = &__shell_cmd_start;
-            flag = 1u;
-        }
-        if (strncmp(pcmd->name, buf, len) == 0)
-        {
-            pmatch_cmd = pcmd;
-            strncpy(buf, pcmd->name, CFG_CBSIZE);
-            strncat(buf, " ", CFG_CBSIZE);
-            return strlen(buf);
-        }
-        if (flag == 1u)
-        {
-            flag = 0u;
-        }
-        else
+    /* Ĺǰ׺βĹǰ׺ */
+    pfirst = the_cmd_index[first]->name;
+    plast = the_cmd_index[first + num - 1u]->name;
+    for (common = len; (pfirst[common] != '\0')
+            && (pfirst[common] == plast[common]); common++)
+    {
+    }
+    common = MIN(common, CFG_CBSIZE - 3u);
+
+    if ((num == 1u) && (pfirst[common] == '\0'))
+    {
+        memcpy(buf, pfirst, common);
+        buf[common++] = ' ';
+        buf[common] = '\0';
+        return (int32_t)common;
+    }
+    if (common > len)
+    {
+        memcpy(buf, pfirst, common);
+        buf[common] = '\0';
+        return (int32_t)common;
+    }
+
+    SHELL_PRINTF("\r\n");
+    for (i = first; i < (first + num); i++)
+    {
+        SHELL_PRINTF("%s  ", the_cmd_index[i]->name);
+    }
+    SHELL_PRINTF("\r\n");
+
+    return (int32_t)len;
+}
+
+/**
+ ******************************************************************************
+ * @brief      ڻỰһַ, ʱȴtty
+ * @param[in]  pio : Ự
+ * @param[out] pch : ַ
+ * @retval     1   : ַ
+ * @retval     0   : ȴʱ
+ *
+ * @details ʱֱӷ, ճʱ; ʱttyĽź
+ *          SHELL_IDLE_TICKS. ̨ttyʱ˻صÿtickѯ.
+ ******************************************************************************
+ */
+static int32_t
+shell_console_getc(shell_io_t *pio, uint8_t *pch)
+{
+    static SEM_ID the_rxsem = NULL;
+    static int32_t the_rxsem_fd = -1;
+
+    (void)pio;
+    if (_the_console_fd <= 0)
+    {
+        taskDelay(1);
+        return ((*pch = bsp_getchar()) == 0) ? 0 : 1;
+    }
+    if (the_rxsem_fd != _the_console_fd)
+    {
+        /* ̨()򿪺ȡһνź */
+        the_rxsem = NULL;
+        if (dev_ioctl(_the_console_fd, TTY_FIORXSEM, &the_rxsem) != 0)
         {
-            pcmd++;
+            the_rxsem = NULL;
         }
-    } while (pcmd != pmatch_cmd);
+        the_rxsem_fd = _the_console_fd;
+    }
 
-    return -2;
+    if (dev_read(_the_console_fd, pch, 1) == 1)
+    {
+        return 1;
+    }
+    if (the_rxsem == NULL)
+    {
+        taskDelay(1);
+    }
+    else
+    {
+        (void)semTake(the_rxsem, SHELL_IDLE_TICKS);
+    }
+    return (dev_read(_the_console_fd, pch, 1) == 1) ? 1 : 0;
 }
 
 /**
  ******************************************************************************
  * @brief      ȡһ
- * @param[in]  None
+ * @param[in]  ps       : Ự
  * @param[out] None
- * @retval     TRUE     : ɹ
- * @retval     FALSE    : ʧ
+ * @retval     1        : ɹ
+ * @retval     0        : ȡ(Ctrl+C)
+ * @retval     -1       : Ựѽ
  *
  * @details
  *
  * @note
  ******************************************************************************
  */
-static bool_e
-readline(void)
+static int32_t
+readline(shell_sess_t *ps)
 {
     uint8_t c;
-    uint8_t *p = console_buffer;
+    uint8_t *p = ps->buf;
     int32_t n = 0;
-    int32_t n_pos = 0;
     int32_t ret;
 
     // ӡʾ
     SHELL_PRINTF(prompt);
     //fflush(stdout);
+    dmn_sign(ps->dmnid);
     while (TRUE)
     {
-        dmn_sign(the_dmnid);
-        taskDelay(1);
         // 
-        if (_the_console_fd <= 0)
+        ret = ps->pio->getc(ps->pio, &c);
+        if (ret < 0)
         {
-            if ((c = bsp_getchar()) == 0)
-                continue;
+            return -1;
         }
-        else
+        if (ret == 0)
         {
-            if (dev_read(_the_console_fd, &c, 1) != 1)
-                continue;
+            dmn_sign(ps->dmnid);    /* ȴʱ, ʱι */
+            continue;
         }
         // ַ
         switch (c)
@@ -217,14 +390,13 @@ readline(void)
         case '\n': // У
             p[n] = '\0';
              SHELL_PRINTF ("\r\n");
-            pmatch_cmd = NULL;
-            return TRUE;
+            return 1;
 
         case 0x03: // Ctrl + C
             // ջ
-            console_buffer[0] = '\0';
+            p[0] = '\0';
             SHELL_PRINTF("\r\n");
-            return FALSE;
+            return 0;
 
         case 0x08: //˸
             if (0 >= n)
@@ -235,19 +407,18 @@ readline(void)
             p[n] = '\0';
             //p--;
             n--;
-            n_pos = n;
-            pmatch_cmd = NULL;
             SHELL_PRINTF(erase_seq);
             continue;
 
         case 0x09: // TAB
-            ret = match_cmd((char_t *)console_buffer, n_pos);
-            if (ret > 0)
+            p[n] = '\0';
+            ret = match_cmd((char_t *)p, (uint32_t)n);
+            if (ret >= 0)   /* гȫʱΪ0, ͬҪػ */
             {
                 n = ret;
                 SHELL_PRINTF("\r");
                 SHELL_PRINTF(prompt);
-                SHELL_PRINTF("%s", console_buffer);
+                SHELL_PRINTF("%s", p);
                 SHELL_PRINTF("\033[0K"); // Clear from cursor to end of line
             }
             continue;
@@ -266,7 +437,6 @@ readline(void)
             // 浽
             p[n] = c;
             n++;
-            n_pos = n;
             break;
         }
     }
@@ -343,7 +513,8 @@ parse_line(char_t *line, char_t *argv[])
  * @brief      ִ
  * @param[in]  char_t *cmd
  * @param[out] None
- * @retval     None
+ * @retval     0        : ȫɹ
+ * @retval          : һʧķֵ, ڻΪ-1
  *
  * @details
  *
@@ -363,6 +534,7 @@ run_command(char_t *cmd)
     int32_t argc, inquotes;
     int32_t rc = 0;
     int32_t len = 0;
+    uint32_t ret;
 
     len = 0;
     len = strlen(cmd);
@@ -437,9 +609,10 @@ run_command(char_t *cmd)
         }
 
         /* OK - call function to do the command */
-        if ((cmdtp->cmd)(cmdtp, argc, (const uint8_t **)argv) != 0)
+        ret = (cmdtp->cmd)(cmdtp, argc, (const uint8_t **)argv);
+        if (ret != 0)
         {
-            rc = -1;
+            rc = (int32_t)ret;
         }
     }
 
@@ -463,12 +636,13 @@ help(void)
 {
     uint8_t *usage;
     cmd_tbl_t *cmdtptemp;
+    uint32_t i;
 
     SHELL_PRINTF("\n");
-    /* print short help (usage) */
-    for (cmdtptemp = &__shell_cmd_start; cmdtptemp != &__shell_cmd_end;
-            cmdtptemp++)
+    /* print short help (usage),  */
+    for (i = 0u; i < the_cmd_num; i++)
     {
+        cmdtptemp = the_cmd_index[i];
         usage = (uint8_t *)cmdtptemp->name;
         if (usage == NULL)
         {
@@ -495,6 +669,60 @@ uint32_t do_help(cmd_tbl_t * cmdtp, uint32_t argc, const uint8_t *argv[])
 
 SHELL_CMD(help, CFG_MAXARGS, do_help, "Print this list\r\n");
 
+/**
+ ******************************************************************************
+ * @brief      һshellỰ, ֱ
+ * @param[in]  pio : Ự, ͨconsole_redirect()ض
+ *
+ * @retval  OK      :   Ự
+ * @retval  ERROR   :   
+ *
+ * @details Ự״̬ڵߵĶջ, ڶͬʱ. ǰӦ
+ *          ѵshell_init().
+ ******************************************************************************
+ */
+status_t
+shell_session(shell_io_t *pio)
+{
+    shell_sess_t sess;
+    int32_t ret;
+
+    if ((pio == NULL) || (pio->getc == NULL))
+    {
+        return ERROR;
+    }
+    sess.pio = pio;
+    sess.dmnid = dmn_register();
+
+    while ((ret = readline(&sess)) >= 0)
+    {
+        if (ret > 0)
+            run_command((char_t *) sess.buf);
+    }
+
+    (void)dmn_unregister(sess.dmnid);
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief      ִһ, ';'ָ
+ * @param[in]  pcmd : 
+ *
+ * @retval     0    : ȫɹ
+ * @retval      : һʧķֵ
+ ******************************************************************************
+ */
+int32_t
+shell_exec(const char_t *pcmd)
+{
+    if (pcmd == NULL)
+    {
+        return -1;
+    }
+    return run_command((char_t *)pcmd);  /* run_commandֻ, ڸϲ */
+}
+
 /**
  ******************************************************************************
  * @brief      shellִ
@@ -510,12 +738,15 @@ SHELL_CMD(help, CFG_MAXARGS, do_help, "Print this list\r\n");
 void
 shell_loop(void)
 {
-    the_dmnid = dmn_register();
+    static shell_io_t the_console_io = { shell_console_getc };
 
+#ifdef SHELL_STARTUP_SCRIPT
+    /* ű, ļʱĬ */
+    (void)script_run(SHELL_STARTUP_SCRIPT, 0u, NULL, 0u);
+#endif
     while (1)
     {
-        if (readline())
-            run_command((char_t *) console_buffer);
+        (void)shell_session(&the_console_io);
     }
 }
 
@@ -534,6 +765,9 @@ shell_init(uint32_t stacksize)
     if (shellTaskId != 0)
         return ERROR; /* already called */
 
+    if (cmd_index_init() != OK)
+        return ERROR;
+
     stacksize = (stacksize == 0) ? TASK_STK_SIZE_SHELL : stacksize;
     shellTaskId = taskSpawn((const signed char * const )"shell",
             TASK_PRIORITY_SHELL, stacksize,
@@ -15,6 +15,7 @@
 #include <types.h>
 #include <oscfg.h>
 #include <oshook.h>
+#include <intLib.h>
 
 /*-----------------------------------------------------------------------------
  Section: Macro Definitions
@@ -24,16 +25,7 @@
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-#pragma pack(push, 1)
-
-/* жջַISRַ */
-typedef union
-{
-    VOIDFUNCPTR routine;     /**< жϴַ */
-    void *msp;               /**< ջַ         */
-} INTVECT_ITEM;
-
-#pragma pack(pop)
+/* INTVECT_ITEMintLib.h */
 
 /*-----------------------------------------------------------------------------
  Section: Global Variables
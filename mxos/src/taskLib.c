@@ -12,28 +12,81 @@
 /*-----------------------------------------------------------------------------
  Section: Includes
  ----------------------------------------------------------------------------*/
-//#include <intLib.h>
+#include <intLib.h>
 #include <taskLib.h>
 #include <FreeRTOS.h>
 #include <task.h>
 #include <queue.h>
 #include <semphr.h>
+#include <string.h>
 
 #include <oscfg.h>
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-/* NONE */
+/** Ϣ, ÿΪ4ֽڳȼϢ */
+typedef struct
+{
+    SEM_ID free;                /**< вۼ */
+    SEM_ID msgs;                /**< Ϣ */
+    uint32_t maxlen;            /**< Ϣ󳤶 */
+    uint32_t slotsize;          /**< ÿֽ */
+    uint16_t maxmsgs;           /**<  */
+    uint16_t head;              /**< Ϣڲ */
+    uint16_t count;             /**< еϢ */
+    uint8_t slots[];            /**< Ϣ */
+} msg_q_t;
+
+/** ¼ĵȴ, ʱԤ, ÿһֵź */
+typedef struct event_waiter_s
+{
+    struct event_waiter_s *pnext;   /**< ȴ */
+    SEM_ID sem;                     /**< ź */
+    uint32_t mask;                  /**< ȴ¼λ */
+    uint32_t options;               /**< EVENT_WAIT_xxx */
+    uint32_t result;                /**< ʱ¼λ */
+    bool_e done;                    /**< , Ѵժ */
+    bool_e busy;                    /**< ѷĳȴ */
+} event_waiter_t;
+
+/** ¼ */
+typedef struct
+{
+    volatile uint32_t bits;         /**< ǰ¼λ */
+    event_waiter_t *pwait;          /**< ȴ */
+    uint32_t nwaiters;              /**< waiters */
+    event_waiter_t waiters[];       /**< ȴ߳ */
+} event_grp_t;
 
 /*-----------------------------------------------------------------------------
  Section: Constant Definitions
  ----------------------------------------------------------------------------*/
-/* NONE */
+#define MSGQ_HDR_SIZE   (sizeof(uint32_t))  /**< ϢгֶεĴС */
+
+/** WAIT_FOREVER/NO_WAITתΪFreeRTOSĵȴtick */
+#define OS_TICKS(timeout)   (((timeout) == WAIT_FOREVER) ? portMAX_DELAY \
+                            : (((timeout) == NO_WAIT) ? 0u : (timeout)))
+
+#ifndef EVENT_MAX_WAITERS
+# define EVENT_MAX_WAITERS  (4u)    /**< ¼ȱʡͬʱȴ */
+#endif
+
+/** жʹ */
+#define SEM_IS_MUTEX(type)  (((type) == queueQUEUE_TYPE_MUTEX) \
+                            || ((type) == queueQUEUE_TYPE_RECURSIVE_MUTEX))
+
+/** жжõٽ, οɵFreeRTOSж, Ƕ */
+#define OS_LOCK(key)        ((key) = intLock())
+#define OS_UNLOCK(key)      intUnlock(key)
+
+#if (configUSE_TRACE_FACILITY != 1)
+# error "semTake/semGiveҪucQueueGetQueueTypeֵݹ黥"
+#endif
 
 /*-----------------------------------------------------------------------------
  Section: Global Variables
  ----------------------------------------------------------------------------*/
-/* NONE */
+volatile unsigned long _the_task_switches = 0;  /**< л */
 
 /*-----------------------------------------------------------------------------
  Section: Local Variables
@@ -66,7 +119,7 @@
  * @retval
  *          TASK_ID             : task handler(task tcb pointer)
  *
- * @details
+ * @details     argֵentryPt, ָ
  *
  * @note
  ******************************************************************************
@@ -77,10 +130,9 @@ taskSpawn(const signed char * const name, uint32_t priority, uint32_t stackSize,
 {
     xTaskHandle createdTask = NULL;
     uint16_t usStackDepth = stackSize / sizeof(long);
-    uint32_t param = arg;
     /* configMAX_PRIORITIESȼ±꣬ȼʱOSڲҲ1 */
     uint32_t prior = (priority >= MAX_TASK_PRIORITIES)?0:(MAX_TASK_PRIORITIES - priority-1);
-    int32_t result = xTaskCreate( (pdTASK_CODE)entryPt, name, usStackDepth,(void *)&param, prior, &createdTask);
+    int32_t result = xTaskCreate( (pdTASK_CODE)entryPt, name, usStackDepth,(void *)arg, prior, &createdTask);
 
      if (result == pdPASS)
     {
@@ -92,6 +144,40 @@ taskSpawn(const signed char * const name, uint32_t priority, uint32_t stackSize,
     }
 }
 
+/**
+ ******************************************************************************
+ * @brief      spawn a task with caller-provided stack and tcb.
+ * @param[in]  name             name of new task
+ * @param[in]   priority        : priority of new task
+ * @param[in]  pstack           : stack memory, 4 bytes aligned
+ * @param[in]  stackSize        : size (bytes) of stack, need a multiple of 4
+ * @param[in]  ptcb             : tcb memory
+ * @param[in]  entryPt          : entry point of new task
+ * @param[in]   arg             : task args to pass to func
+ * @retval
+ *          TASK_ID             : task handler(task tcb pointer)
+ *          NULL                : TASK_TCB_SIZEСںTCB
+ *
+ * @details     Ӷѷڴ, ջtcbǾ̬, Ҳڴ
+ *              (RAM). ɾڴ治ͷ, ȿ
+ *              .
+ ******************************************************************************
+ */
+extern TASK_ID
+taskSpawnStatic(const signed char * const name, uint32_t priority,
+        void *pstack, uint32_t stackSize, task_tcb_t *ptcb,
+        OSFUNCPTR entryPt, uint32_t arg)
+{
+    xTaskHandle createdTask = NULL;
+    uint16_t usStackDepth = stackSize / sizeof(long);
+    uint32_t prior = (priority >= MAX_TASK_PRIORITIES)?0:(MAX_TASK_PRIORITIES - priority-1);
+    int32_t result = xTaskCreateStatic((pdTASK_CODE)entryPt, name,
+            usStackDepth, (void *)arg, prior, &createdTask,
+            (portSTACK_TYPE *)pstack, ptcb, sizeof(task_tcb_t));
+
+    return (result == pdPASS) ? (TASK_ID)createdTask : NULL;
+}
+
 /**
  ******************************************************************************
  * @brief      delete a task.
@@ -290,6 +376,51 @@ semBCreate(uint32_t cnt)
     return xSemaphore;
 }
 
+/**
+ ******************************************************************************
+ * @brief      this function creates a mutual exclusion semaphore.
+ * @param[in]   options  0, or SEM_RECURSIVE for a recursive mutex
+ * @retval     Return the new semaphore ID
+ *
+ * @details     ʼΪɻȡ״̬, ȼ̳: ȼȴʱʱ
+ *              ȴߵȼ. ֻɳͷ, жʹ.
+ *              SEM_RECURSIVEʱ߿ظȡ, ͷͬͷ.
+ *
+ * @note
+ ******************************************************************************
+ */
+extern SEM_ID
+semMCreate(uint32_t options)
+{
+    if ((options & SEM_RECURSIVE) != 0u)
+    {
+        return xSemaphoreCreateRecursiveMutex();
+    }
+    return xSemaphoreCreateMutex();
+}
+
+/**
+ ******************************************************************************
+ * @brief      this function creates a counting semaphore.
+ * @param[in]   cnt    the initial value for the semaphore
+ * @param[in]   max    the maximum value for the semaphore
+ * @retval     Return the new semaphore ID, NULL if cnt > max or max is 0
+ *
+ * @details
+ *
+ * @note
+ ******************************************************************************
+ */
+extern SEM_ID
+semCCreate(uint32_t cnt, uint32_t max)
+{
+    if ((max == 0u) || (cnt > max))
+    {
+        return NULL;
+    }
+    return xSemaphoreCreateCounting(max, cnt);
+}
+
 /**
  ******************************************************************************
  * @brief      This function delete a mutual exclusion semaphore.
@@ -311,10 +442,10 @@ semDelete(SEM_ID semId)
  ******************************************************************************
  * @brief      This function waits for a mutual exclusion semaphore.
  * @param[in]   semId    semaphore ID to delete
- * @param[in]  timeout   timeout in ticks
+ * @param[in]  timeout   timeout in ticks, WAIT_FOREVER or NO_WAIT
  * @retval         OK on success, ERROR otherwise
  *
- * @details
+ * @details     ж(жʱ)ȴ, ; жлȡ.
  *
  * @note
  ******************************************************************************
@@ -323,14 +454,26 @@ extern status_t
 semTake(SEM_ID semId, uint32_t timeout)
 {
     signed portBASE_TYPE  pdRtn = pdFALSE;
+    signed portBASE_TYPE  woken = pdFALSE;
+    unsigned char type = ucQueueGetQueueType(semId);
 
-    timeout = (timeout == 0u) ? portMAX_DELAY : timeout;
+    timeout = OS_TICKS(timeout);
 
-//    if (intContext() == TRUE)
-//    {
-//        pdRtn = xSemaphoreTakeFromISR(semId, NULL);   //fixme: δ
-//    }
-//    else
+    if (intContext() == TRUE)
+    {
+        /* жвܵȴ, Ҳܻȡ */
+        if (SEM_IS_MUTEX(type))
+        {
+            return ERROR;
+        }
+        pdRtn = xSemaphoreTakeFromISR(semId, &woken);
+        portEND_SWITCHING_ISR(woken);
+    }
+    else if (type == queueQUEUE_TYPE_RECURSIVE_MUTEX)
+    {
+        pdRtn = xSemaphoreTakeRecursive(semId, timeout);
+    }
+    else
     {
         pdRtn = xSemaphoreTake(semId, timeout);
     }
@@ -344,7 +487,8 @@ semTake(SEM_ID semId, uint32_t timeout)
  * @param[in]   semId   Semaphore ID to give
  * @retval         OK on success, ERROR otherwise
  *
- * @details
+ * @details     же(жȼø
+ *              configMAX_SYSCALL_INTERRUPT_PRIORITY), .
  *
  * @note
  ******************************************************************************
@@ -353,12 +497,24 @@ extern status_t
 semGive(SEM_ID semId)
 {
     signed portBASE_TYPE  pdRtn = pdFALSE;
+    signed portBASE_TYPE  woken = pdFALSE;
+    unsigned char type = ucQueueGetQueueType(semId);
 
-//    if (intContext() == TRUE)
-//    {
-//        pdRtn = xSemaphoreGiveFromISR(semId, NULL);   //fixme: δ
-//    }
-//    else
+    if (intContext() == TRUE)
+    {
+        if (SEM_IS_MUTEX(type))
+        {
+            return ERROR;
+        }
+        /* ˸ȼʱPendSV, ˳жϺл */
+        pdRtn = xSemaphoreGiveFromISR(semId, &woken);
+        portEND_SWITCHING_ISR(woken);
+    }
+    else if (type == queueQUEUE_TYPE_RECURSIVE_MUTEX)
+    {
+        pdRtn = xSemaphoreGiveRecursive(semId);
+    }
+    else
     {
         pdRtn = xSemaphoreGive(semId);
     }
@@ -375,86 +531,176 @@ semGive(SEM_ID semId)
 /**
  ******************************************************************************
  * @brief      creates a message queue.
- * @param[in]   msgQLen : the number of elements in the storage area
- * @retval     Return the queue id to create.
+ * @param[in]   maxMsgs      : max messages that can be queued
+ * @param[in]   maxMsgLength : max bytes in a message
+ * @retval     Return the queue id to create, NULL if no memory.
  *
- * @details  This function creates a message queue if free event control blocks
- * are available.
+ * @details  ϢʱһηĲ, շٷڴ. ٽ
+ *           , maxMsgLengthС; ݿָֻ(sizeof(void *)).
  *
  * @note
  ******************************************************************************
  */
 extern MSG_Q_ID
-msgQCreate(uint32_t msgQLen)
+msgQCreate(uint32_t maxMsgs, uint32_t maxMsgLength)
 {
-    return (MSG_Q_ID) xQueueCreate(msgQLen, sizeof(void *));
+    msg_q_t *pq;
+    uint32_t slotsize = MSGQ_HDR_SIZE + ((maxMsgLength + 3u) & ~3u);
+
+    if ((maxMsgs == 0u) || (maxMsgs > 0xFFFFu))
+    {
+        return NULL;
+    }
+    pq = pvPortMalloc(sizeof(msg_q_t) + (maxMsgs * slotsize));
+    if (pq == NULL)
+    {
+        return NULL;
+    }
+    pq->free = semCCreate(maxMsgs, maxMsgs);
+    pq->msgs = semCCreate(0u, maxMsgs);
+    if ((pq->free == NULL) || (pq->msgs == NULL))
+    {
+        if (pq->free != NULL)
+        {
+            semDelete(pq->free);
+        }
+        if (pq->msgs != NULL)
+        {
+            semDelete(pq->msgs);
+        }
+        vPortFree(pq);
+        return NULL;
+    }
+    pq->maxlen = maxMsgLength;
+    pq->slotsize = slotsize;
+    pq->maxmsgs = (uint16_t)maxMsgs;
+    pq->head = 0u;
+    pq->count = 0u;
+
+    return (MSG_Q_ID)pq;
+}
+
+/**
+ ******************************************************************************
+ * @brief      deletes a message queue.
+ * @param[in]   msgQId : msgQId to delete
+ *
+ * @details  뱣֤ûշö
+ *
+ * @note
+ ******************************************************************************
+ */
+extern void
+msgQDelete(MSG_Q_ID msgQId)
+{
+    msg_q_t *pq = (msg_q_t *)msgQId;
+
+    semDelete(pq->free);
+    semDelete(pq->msgs);
+    vPortFree(pq);
 }
 
 /**
  ******************************************************************************
  * @brief      sends a message to a queue.
  * @param[in]     msgQId    msgQId associated with the desired queue
- * @param[in]     pmsg        A pointer to the message to send
+ * @param[in]     buffer    message to send
+ * @param[in]     nBytes    length of message, no more than maxMsgLength
+ * @param[in]     timeout   ticks to wait when full, WAIT_FOREVER or NO_WAIT
+ * @param[in]     priority  MSG_PRI_NORMAL or MSG_PRI_URGENT
  * @retval         OK on success, ERROR otherwise
  *
- * @details
+ * @details  MSG_PRI_URGENTϢŵ, һνռȡ.
+ *           же, ʱȴ.
  *
  * @note
  ******************************************************************************
  */
 extern status_t
-msgQSend(MSG_Q_ID msgQId, void *pmsg)
+msgQSend(MSG_Q_ID msgQId, const void *buffer, uint32_t nBytes,
+        uint32_t timeout, uint32_t priority)
 {
-    signed portBASE_TYPE  pdRtn = pdFALSE;
+    msg_q_t *pq = (msg_q_t *)msgQId;
+    uint8_t *pslot;
+    uint32_t slot;
+    uint32_t key;
+
+    if ((pq == NULL) || (nBytes > pq->maxlen))
+    {
+        return ERROR;
+    }
+    if (semTake(pq->free, timeout) != OK)
+    {
+        return ERROR;
+    }
 
-//    if (intContext() == TRUE)
-//    {
-//        pdRtn = xQueueSendFromISR(msgQId, &pmsg, NULL);   //fixme: δ
-//
-//    }
-//    else
+    OS_LOCK(key);
+    if (priority == MSG_PRI_URGENT)
     {
-        pdRtn = xQueueSend(msgQId, &pmsg, 0);
+        pq->head = (pq->head == 0u) ? (pq->maxmsgs - 1u) : (pq->head - 1u);
+        slot = pq->head;
     }
+    else
+    {
+        slot = pq->head + pq->count;
+        if (slot >= pq->maxmsgs)
+        {
+            slot -= pq->maxmsgs;
+        }
+    }
+    pq->count++;
+    pslot = &pq->slots[slot * pq->slotsize];
+    *(uint32_t *)pslot = nBytes;
+    memcpy(pslot + MSGQ_HDR_SIZE, buffer, nBytes);
+    OS_UNLOCK(key);
 
-    return (pdRtn == pdTRUE) ? OK : ERROR;
+    (void)semGive(pq->msgs);
+    return OK;
 }
 
 /**
  ******************************************************************************
  * @brief      waits for a message to be sent to a queue.
  * @param[in]   msgQId      msgQId associated with the desired queue
- * @param[in]    timeout      ticks to wait
- * @param[in]    pmsg        a pointer to the message to recv
- * @retval         OK on success, ERROR otherwise
+ * @param[out]  buffer      buffer to receive message
+ * @param[in]   maxNBytes   length of buffer
+ * @param[in]   timeout     ticks to wait, WAIT_FOREVER or NO_WAIT
+ * @retval      >= 0        bytes received, longer message is truncated
+ * @retval      -1          timeout or error
  *
- * @details
+ * @details  же, ʱȴ
  *
  * @note
  ******************************************************************************
  */
-extern status_t
-msgQReceive(MSG_Q_ID msgQId, uint32_t timeout, void **pmsg)
+extern int32_t
+msgQReceive(MSG_Q_ID msgQId, void *buffer, uint32_t maxNBytes,
+        uint32_t timeout)
 {
-    signed portBASE_TYPE  pdRtn = pdFALSE;
-    void * dummyptr;
+    msg_q_t *pq = (msg_q_t *)msgQId;
+    uint8_t *pslot;
+    uint32_t len;
+    uint32_t key;
 
-    if (pmsg == NULL)
+    if ((pq == NULL) || (semTake(pq->msgs, timeout) != OK))
     {
-        pmsg = &dummyptr;
+        return -1;
     }
 
-    timeout = (timeout == 0u) ? portMAX_DELAY : timeout;
-//    if (intContext() == TRUE)
-//    {
-////        pdRtn = xQueueCRReceiveFromISR()( msgQId, &(*pmsg), timeout );//fixme: δ
-//    }
-//    else
+    OS_LOCK(key);
+    pslot = &pq->slots[pq->head * pq->slotsize];
+    len = *(uint32_t *)pslot;
+    len = (len > maxNBytes) ? maxNBytes : len;
+    if (buffer != NULL)
     {
-        pdRtn = xQueueReceive( msgQId, &(*pmsg), timeout );
+        memcpy(buffer, pslot + MSGQ_HDR_SIZE, len);
     }
+    pq->head = (pq->head + 1u == pq->maxmsgs) ? 0u : (pq->head + 1u);
+    pq->count--;
+    OS_UNLOCK(key);
 
-    return (pdRtn == pdTRUE) ? OK : ERROR;
+    (void)semGive(pq->free);
+    return (int32_t)len;
 }
 
 /**
@@ -471,8 +717,417 @@ msgQReceive(MSG_Q_ID msgQId, uint32_t timeout, void **pmsg)
 extern int
 msgQNumMsgs(MSG_Q_ID msgQId)
 {
-    return uxQueueMessagesWaiting(msgQId);
+    return ((msg_q_t *)msgQId)->count;
+}
+
+/*
+ *******************************************************************************
+ *                                EVENT INTERFACE
+ *******************************************************************************
+ */
+
+/**
+ ******************************************************************************
+ * @brief      creates an event group.
+ * @param[in]   maxWaiters : max tasks waiting at the same time, 0 for default
+ * @retval     Return the event group id, NULL if no memory.
+ *
+ * @details  ȴߺǵźڴʱ, λ/ȴʱٷڴ.
+ *
+ * @note
+ ******************************************************************************
+ */
+extern EVENT_ID
+eventCreate(uint32_t maxWaiters)
+{
+    event_grp_t *pev;
+    uint32_t i;
+
+    maxWaiters = (maxWaiters == 0u) ? EVENT_MAX_WAITERS : maxWaiters;
+    pev = pvPortMalloc(sizeof(event_grp_t)
+            + (maxWaiters * sizeof(event_waiter_t)));
+    if (pev == NULL)
+    {
+        return NULL;
+    }
+    memset(pev, 0, sizeof(event_grp_t) + (maxWaiters * sizeof(event_waiter_t)));
+    pev->nwaiters = maxWaiters;
+    for (i = 0u; i < maxWaiters; i++)
+    {
+        pev->waiters[i].sem = semBCreate(0);
+        if (pev->waiters[i].sem == NULL)
+        {
+            eventDelete(pev);
+            return NULL;
+        }
+    }
+
+    return (EVENT_ID)pev;
+}
+
+/**
+ ******************************************************************************
+ * @brief      deletes an event group.
+ * @param[in]   eventId : event group to delete
+ *
+ * @details  뱣֤ûڵȴ
+ *
+ * @note
+ ******************************************************************************
+ */
+extern void
+eventDelete(EVENT_ID eventId)
+{
+    event_grp_t *pev = (event_grp_t *)eventId;
+    uint32_t i;
+
+    for (i = 0u; i < pev->nwaiters; i++)
+    {
+        if (pev->waiters[i].sem != NULL)
+        {
+            semDelete(pev->waiters[i].sem);
+        }
+    }
+    vPortFree(pev);
+}
+
+/**
+ ******************************************************************************
+ * @brief      ȴǷ
+ ******************************************************************************
+ */
+static bool_e
+event_match(uint32_t bits, uint32_t mask, uint32_t options)
+{
+    if ((options & EVENT_WAIT_ALL) != 0u)
+    {
+        return ((bits & mask) == mask) ? TRUE : FALSE;
+    }
+    return ((bits & mask) != 0u) ? TRUE : FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief      sets bits in an event group and wakes the satisfied waiters.
+ * @param[in]   eventId : event group
+ * @param[in]   bits    : bits to set
+ * @retval     Return the event bits after waiters consumed EVENT_CLEAR bits.
+ *
+ * @details  же. ĵȴһλ, ĵȴ߲
+ *           ʱmaxWaiters, ִʱн.
+ *
+ * @note
+ ******************************************************************************
+ */
+extern uint32_t
+eventSet(EVENT_ID eventId, uint32_t bits)
+{
+    event_grp_t *pev = (event_grp_t *)eventId;
+    event_waiter_t **pp;
+    event_waiter_t *pw;
+    signed portBASE_TYPE woken = pdFALSE;
+    uint32_t clear = 0u;
+    uint32_t now;
+    uint32_t key;
+
+    OS_LOCK(key);
+    pev->bits |= bits;
+    now = pev->bits;
+    pp = &pev->pwait;
+    while ((pw = *pp) != NULL)
+    {
+        if (event_match(now, pw->mask, pw->options) == TRUE)
+        {
+            *pp = pw->pnext;    /* ժ, ȴ󲻱ٲ */
+            pw->result = now;
+            pw->done = TRUE;
+            if ((pw->options & EVENT_CLEAR) != 0u)
+            {
+                clear |= pw->mask;
+            }
+            (void)xSemaphoreGiveFromISR(pw->sem, &woken);
+        }
+        else
+        {
+            pp = &pw->pnext;
+        }
+    }
+    pev->bits &= ~clear;
+    now = pev->bits;
+    OS_UNLOCK(key);
+
+    portEND_SWITCHING_ISR(woken);
+    return now;
 }
+
+/**
+ ******************************************************************************
+ * @brief      clears bits in an event group.
+ * @param[in]   eventId : event group
+ * @param[in]   bits    : bits to clear
+ * @retval     Return the event bits before clearing.
+ *
+ * @details  же
+ *
+ * @note
+ ******************************************************************************
+ */
+extern uint32_t
+eventClear(EVENT_ID eventId, uint32_t bits)
+{
+    event_grp_t *pev = (event_grp_t *)eventId;
+    uint32_t old;
+    uint32_t key;
+
+    OS_LOCK(key);
+    old = pev->bits;
+    pev->bits = old & ~bits;
+    OS_UNLOCK(key);
+
+    return old;
+}
+
+/**
+ ******************************************************************************
+ * @brief      gets the bits of an event group.
+ * @param[in]   eventId : event group
+ * @retval     Return the current event bits.
+ ******************************************************************************
+ */
+extern uint32_t
+eventGet(EVENT_ID eventId)
+{
+    return ((event_grp_t *)eventId)->bits;
+}
+
+/**
+ ******************************************************************************
+ * @brief      waits for any or all of the bits in an event group.
+ * @param[in]   eventId : event group
+ * @param[in]   bits    : bits to wait for
+ * @param[in]   options : EVENT_WAIT_ANY or EVENT_WAIT_ALL, | EVENT_CLEAR to
+ *                        clear the waited bits on success
+ * @param[in]   timeout : ticks to wait, WAIT_FOREVER or NO_WAIT
+ * @param[out]  pbits   : event bits when satisfied or timed out, may be NULL
+ * @retval     OK on success, ERROR on timeout or no free waiter
+ *
+ * @details  жеʱȴ
+ *
+ * @note
+ ******************************************************************************
+ */
+extern status_t
+eventWait(EVENT_ID eventId, uint32_t bits, uint32_t options, uint32_t timeout,
+        uint32_t *pbits)
+{
+    event_grp_t *pev = (event_grp_t *)eventId;
+    event_waiter_t **pp;
+    event_waiter_t *pw = NULL;
+    status_t ret = ERROR;
+    uint32_t now;
+    uint32_t i;
+    uint32_t key;
+
+    if ((pev == NULL) || (bits == 0u))
+    {
+        return ERROR;
+    }
+    if (intContext() == TRUE)
+    {
+        timeout = NO_WAIT;
+    }
+
+    OS_LOCK(key);
+    now = pev->bits;
+    if (event_match(now, bits, options) == TRUE)
+    {
+        if ((options & EVENT_CLEAR) != 0u)
+        {
+            pev->bits &= ~bits;
+        }
+        ret = OK;
+    }
+    else if (timeout != NO_WAIT)
+    {
+        for (i = 0u; i < pev->nwaiters; i++)
+        {
+            if (pev->waiters[i].busy == FALSE)
+            {
+                pw = &pev->waiters[i];
+                pw->busy = TRUE;
+                pw->done = FALSE;
+                pw->mask = bits;
+                pw->options = options;
+                pw->pnext = pev->pwait;
+                pev->pwait = pw;
+                break;
+            }
+        }
+    }
+    OS_UNLOCK(key);
+
+    if (pw != NULL)
+    {
+        (void)xSemaphoreTake(pw->sem, OS_TICKS(timeout));
+
+        OS_LOCK(key);
+        if (pw->done == TRUE)
+        {
+            /* eventSetժ; ʱλͬʱʱȡ߶ź */
+            (void)xSemaphoreTakeFromISR(pw->sem, NULL);
+            now = pw->result;
+            ret = OK;
+        }
+        else
+        {
+            for (pp = &pev->pwait; *pp != NULL; pp = &(*pp)->pnext)
+            {
+                if (*pp == pw)
+                {
+                    *pp = pw->pnext;
+                    break;
+                }
+            }
+            now = pev->bits;
+        }
+        pw->busy = FALSE;
+        OS_UNLOCK(key);
+    }
+
+    if (pbits != NULL)
+    {
+        *pbits = now;
+    }
+    return ret;
+}
+
+/*
+ *******************************************************************************
+ *                                NOTIFY INTERFACE
+ *******************************************************************************
+ */
+
+/**
+ ******************************************************************************
+ * @brief      gives a notification signal to a task.
+ * @param[in]   tid : task to notify
+ * @retval     OK    : success
+ * @retval     ERROR : invalid task
+ *
+ * @details  же. ֵ֪ͨTCB, , semGive
+ *           ռöڴ. һֻԼtaskNotifyTakeȴ, ʺж
+ *           ѹ̶ĳ.
+ *
+ * @note
+ ******************************************************************************
+ */
+extern status_t
+taskNotifyGive(TASK_ID tid)
+{
+    signed portBASE_TYPE woken = pdFALSE;
+
+    if (tid == NULL)
+    {
+        return ERROR;
+    }
+    if (intContext() == TRUE)
+    {
+        vTaskNotifyGiveFromISR(tid, &woken);
+        portEND_SWITCHING_ISR(woken);
+    }
+    else
+    {
+        (void)xTaskNotifyGive(tid);
+    }
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief      waits for notification signals to the calling task.
+ * @param[in]   clear   : TRUE: ֵź, ȡ; FALSE: ź, ȡһ
+ * @param[in]   timeout : WAIT_FOREVER, NO_WAIT or ticks
+ * @retval     Return the signal count before taking, 0 if timed out.
+ *
+ * @details
+ *
+ * @note
+ ******************************************************************************
+ */
+extern uint32_t
+taskNotifyTake(bool_e clear, uint32_t timeout)
+{
+    return ulTaskNotifyTake((clear == TRUE) ? pdTRUE : pdFALSE,
+            OS_TICKS(timeout));
+}
+
+/**
+ ******************************************************************************
+ * @brief      sends a 32-bit value to a task's notification mailbox.
+ * @param[in]   tid       : task to notify
+ * @param[in]   value     : value to send
+ * @param[in]   overwrite : TRUE: δֵ; FALSE: δֵʱERROR
+ * @retval     OK    : success
+ * @retval     ERROR : invalid task, or mailbox full and not overwrite
+ *
+ * @details  же. taskNotifyGiveֵ֪ͨ, ͬһֻһ.
+ *
+ * @note
+ ******************************************************************************
+ */
+extern status_t
+taskNotifySend(TASK_ID tid, uint32_t value, bool_e overwrite)
+{
+    signed portBASE_TYPE woken = pdFALSE;
+    portBASE_TYPE pdRtn;
+    eNotifyAction action = (overwrite == TRUE) ? eSetValueWithOverwrite
+            : eSetValueWithoutOverwrite;
+
+    if (tid == NULL)
+    {
+        return ERROR;
+    }
+    if (intContext() == TRUE)
+    {
+        pdRtn = xTaskNotifyFromISR(tid, value, action, &woken);
+        portEND_SWITCHING_ISR(woken);
+    }
+    else
+    {
+        pdRtn = xTaskNotify(tid, value, action);
+    }
+    return (pdRtn == pdPASS) ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief      receives a value from the calling task's notification mailbox.
+ * @param[out]  pvalue  : value received, may be NULL
+ * @param[in]   timeout : WAIT_FOREVER, NO_WAIT or ticks
+ * @retval     OK    : value received
+ * @retval     ERROR : timed out
+ *
+ * @details
+ *
+ * @note
+ ******************************************************************************
+ */
+extern status_t
+taskNotifyReceive(uint32_t *pvalue, uint32_t timeout)
+{
+    unsigned long value = 0u;
+
+    if (xTaskNotifyWait(0u, 0u, &value, OS_TICKS(timeout)) != pdTRUE)
+    {
+        return ERROR;
+    }
+    if (pvalue != NULL)
+    {
+        *pvalue = (uint32_t)value;
+    }
+    return OK;
+}
+
 /**
  * @}
  */
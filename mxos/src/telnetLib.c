@@ -0,0 +1,503 @@
+/**
+ ******************************************************************************
+ * @file      telnetLib.c
+ * @brief     ʵֻlwIP netconntelnet shell.
+ * @details   telnetdTCP˿, ÿӴһỰ
+ *            shell_session(). Ựprintfͨconsole_redirect()
+ *            дỰͻ, ڵȴǰ򻺳ʱһnetconn_write,
+ *            ÿַһTCP. ỰMEMP_NUM_NETCONN.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <types.h>
+#include <taskLib.h>
+#include <debug.h>
+#include <shell.h>
+#include <telnetLib.h>
+#include <lwip/api.h>
+#include <oscfg.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef TASK_PRIORITY_TELNET
+# define TASK_PRIORITY_TELNET        (2u)    /**< telnetȼ */
+#endif
+
+#ifndef TASK_STK_SIZE_TELNETD
+# define TASK_STK_SIZE_TELNETD     (512u)    /**< ջ */
+#endif
+
+#ifndef TASK_STK_SIZE_TELNET
+# define TASK_STK_SIZE_TELNET     (2048u)    /**< Ựջ */
+#endif
+
+#ifndef TELNET_MAX_SESSIONS
+# define TELNET_MAX_SESSIONS         (1u)    /**< Ự */
+#endif
+
+#ifndef TELNET_TX_SIZE
+# define TELNET_TX_SIZE            (512u)    /**< ỰͻС */
+#endif
+
+#ifndef TELNET_POLL_MS
+# define TELNET_POLL_MS           (1000u)    /**< ȴĳʱ(ι) */
+#endif
+
+#define TELNET_PORT                  (23u)
+
+/* RFC854  */
+#define TN_SE       (240u)
+#define TN_SB       (250u)
+#define TN_WILL     (251u)
+#define TN_DONT     (254u)
+#define TN_IAC      (255u)
+#define TN_ECHO       (1u)
+#define TN_SGA        (3u)
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ״̬ */
+typedef enum
+{
+    TN_STATE_DATA = 0,
+    TN_STATE_IAC,
+    TN_STATE_OPT,
+    TN_STATE_SB,
+    TN_STATE_SB_IAC
+} tn_state_e;
+
+/** Ự */
+typedef struct
+{
+    shell_io_t io;              /**< shell, ǵһԱ */
+    struct netconn *pconn;      /**< , NULLʾ */
+    TASK_ID tid;                /**< Ự */
+    struct netbuf *prx;         /**< δĽ */
+    uint8_t *prx_data;          /**< ǰշƬ */
+    uint16_t rx_len;            /**< ǰƬ */
+    uint16_t rx_pos;            /**< ǰƬλ */
+    tn_state_e state;           /**< ״̬ */
+    bool_e last_cr;             /**< һַΪ'\r' */
+    volatile bool_e closing;    /**< logoutر */
+    uint32_t tx_len;            /**< ͻеֽ */
+    uint8_t tx[TELNET_TX_SIZE]; /**< ͻ */
+} telnet_sess_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static TASK_ID the_telnetd_id = NULL;
+static uint16_t the_telnet_port = TELNET_PORT;
+static telnet_sess_t the_telnet_sess[TELNET_MAX_SESSIONS];
+static uint32_t the_telnet_accepted = 0u;
+static uint32_t the_telnet_rejected = 0u;
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ͻе
+ * @param[in]  ps : Ự
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+telnet_flush(telnet_sess_t *ps)
+{
+    if (ps->tx_len == 0u)
+    {
+        return;
+    }
+    if (netconn_write(ps->pconn, ps->tx, ps->tx_len, NETCONN_COPY) != ERR_OK)
+    {
+        ps->closing = TRUE;
+    }
+    ps->tx_len = 0u;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ựprintf, '\n'תΪ"\r\n", 0xffת
+ * @param[in]  pctx : Ự
+ * @param[in]  pstr : 
+ * @param[in]  len  : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+telnet_out(void *pctx, const char_t *pstr, uint32_t len)
+{
+    telnet_sess_t *ps = (telnet_sess_t *)pctx;
+    uint8_t c;
+
+    while (len-- != 0u)
+    {
+        if ((ps->tx_len + 2u) > TELNET_TX_SIZE)
+        {
+            telnet_flush(ps);
+        }
+        c = (uint8_t)*pstr++;
+        if (c == '\n')
+        {
+            ps->tx[ps->tx_len++] = '\r';
+        }
+        else if (c == TN_IAC)
+        {
+            ps->tx[ps->tx_len++] = TN_IAC;
+        }
+        ps->tx[ps->tx_len++] = c;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   telnetͻ, ˸ͳһΪ0x08
+ * @param[in]  ps  : Ự
+ * @param[in,out] pch : ַ
+ *
+ * @retval     TRUE  : shell
+ * @retval     FALSE : 
+ ******************************************************************************
+ */
+static bool_e
+telnet_filter(telnet_sess_t *ps, uint8_t *pch)
+{
+    uint8_t c = *pch;
+
+    switch (ps->state)
+    {
+    case TN_STATE_IAC:
+        if (c == TN_IAC)
+        {
+            ps->state = TN_STATE_DATA;
+            return TRUE;
+        }
+        ps->state = ((c >= TN_WILL) && (c <= TN_DONT)) ? TN_STATE_OPT
+                : (c == TN_SB) ? TN_STATE_SB : TN_STATE_DATA;
+        return FALSE;
+
+    case TN_STATE_OPT:
+        ps->state = TN_STATE_DATA;  /* Э, ԶԷӦ */
+        return FALSE;
+
+    case TN_STATE_SB:
+        if (c == TN_IAC)
+        {
+            ps->state = TN_STATE_SB_IAC;
+        }
+        return FALSE;
+
+    case TN_STATE_SB_IAC:
+        ps->state = (c == TN_SE) ? TN_STATE_DATA : TN_STATE_SB;
+        return FALSE;
+
+    default:
+        break;
+    }
+
+    if (c == TN_IAC)
+    {
+        ps->state = TN_STATE_IAC;
+        return FALSE;
+    }
+    /* سΪ"\r\n""\r\0", ֻ'\r' */
+    if ((ps->last_cr == TRUE) && ((c == '\n') || (c == '\0')))
+    {
+        ps->last_cr = FALSE;
+        return FALSE;
+    }
+    ps->last_cr = (c == '\r') ? TRUE : FALSE;
+    if (c == 0x7f)
+    {
+        *pch = 0x08;
+    }
+    return TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ựһַ, ݶʱȷͻеٵȴ
+ * @param[in]  pio : Ự
+ * @param[out] pch : ַ
+ *
+ * @retval     1   : ַ
+ * @retval     0   : ʱ
+ * @retval     -1  : ӶϿlogout
+ ******************************************************************************
+ */
+static int32_t
+telnet_getc(shell_io_t *pio, uint8_t *pch)
+{
+    telnet_sess_t *ps = (telnet_sess_t *)pio;
+    void *pdata;
+    uint16_t len;
+    err_t err;
+
+    while (ps->closing == FALSE)
+    {
+        if (ps->prx == NULL)
+        {
+            telnet_flush(ps);
+            err = netconn_recv(ps->pconn, &ps->prx);
+            if (err == ERR_TIMEOUT)
+            {
+                return 0;
+            }
+            if (err != ERR_OK)
+            {
+                ps->prx = NULL;
+                return -1;
+            }
+            (void)netbuf_data(ps->prx, &pdata, &len);
+            ps->prx_data = pdata;
+            ps->rx_len = len;
+            ps->rx_pos = 0u;
+        }
+
+        if (ps->rx_pos >= ps->rx_len)
+        {
+            if (netbuf_next(ps->prx) < 0)
+            {
+                netbuf_delete(ps->prx);
+                ps->prx = NULL;
+            }
+            else
+            {
+                (void)netbuf_data(ps->prx, &pdata, &len);
+                ps->prx_data = pdata;
+                ps->rx_len = len;
+                ps->rx_pos = 0u;
+            }
+            continue;
+        }
+
+        *pch = ps->prx_data[ps->rx_pos++];
+        if (telnet_filter(ps, pch) == TRUE)
+        {
+            return 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ựִ
+ * @param[in]  ps : Ự
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+telnet_session_loop(telnet_sess_t *ps)
+{
+    static const uint8_t the_negotiate[] =
+    {
+        TN_IAC, TN_WILL, TN_ECHO, TN_IAC, TN_WILL, TN_SGA
+    };
+
+    ps->tid = taskIdSelf();
+
+    /* ɱ˻, ַģʽ */
+    memcpy(ps->tx, the_negotiate, sizeof(the_negotiate));
+    ps->tx_len = sizeof(the_negotiate);
+    if (console_redirect(ps->tid, telnet_out, ps) == OK)
+    {
+        printf("\nmxos telnet shell, 'logout' to exit\n");
+        (void)shell_session(&ps->io);
+        telnet_flush(ps);
+        (void)console_redirect(ps->tid, NULL, NULL);
+    }
+
+    if (ps->prx != NULL)
+    {
+        netbuf_delete(ps->prx);
+        ps->prx = NULL;
+    }
+    (void)netconn_close(ps->pconn);
+    (void)netconn_delete(ps->pconn);
+    ps->pconn = NULL;   /* ͷŻỰ */
+
+    taskDelete(NULL);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ΪӷỰỰ
+ * @param[in]  pconn : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+telnet_accept(struct netconn *pconn)
+{
+    telnet_sess_t *ps = NULL;
+    uint32_t i;
+
+    for (i = 0u; i < TELNET_MAX_SESSIONS; i++)
+    {
+        if (the_telnet_sess[i].pconn == NULL)
+        {
+            ps = &the_telnet_sess[i];
+            break;
+        }
+    }
+    if (ps != NULL)
+    {
+        memset(ps, 0, sizeof(*ps));
+        ps->io.getc = telnet_getc;
+        ps->pconn = pconn;
+        netconn_set_recvtimeout(pconn, TELNET_POLL_MS);
+
+        if (taskSpawn((const signed char * const )"telnet",
+                TASK_PRIORITY_TELNET, TASK_STK_SIZE_TELNET,
+                (OSFUNCPTR)telnet_session_loop, (uint32_t)ps) != NULL)
+        {
+            the_telnet_accepted++;
+            return;
+        }
+        ps->pconn = NULL;
+    }
+
+    the_telnet_rejected++;
+    (void)netconn_write(pconn, "too many sessions\r\n",
+            sizeof("too many sessions\r\n") - 1u, NETCONN_COPY);
+    (void)netconn_close(pconn);
+    (void)netconn_delete(pconn);
+}
+
+/**
+ ******************************************************************************
+ * @brief   telnetdִ
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+telnet_loop(void)
+{
+    struct netconn *plisten;
+    struct netconn *pconn;
+
+    plisten = netconn_new(NETCONN_TCP);
+    D_ASSERT(plisten != NULL);
+    if ((plisten == NULL)
+            || (netconn_bind(plisten, IP_ADDR_ANY, the_telnet_port) != ERR_OK)
+            || (netconn_listen(plisten) != ERR_OK))
+    {
+        printf("telnetd: listen on port %u failed\n", the_telnet_port);
+        the_telnetd_id = NULL;
+        taskDelete(NULL);
+        return;
+    }
+
+    while (1)
+    {
+        if (netconn_accept(plisten, &pconn) == ERR_OK)
+        {
+            telnet_accept(pconn);
+        }
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   telnet, tcpip_initshell_init֮
+ * @param[in]  port      : ˿, 0ʹ23
+ * @param[in]  stacksize : ջС, 0ʹĬֵ
+ *
+ * @retval  OK      : ʼɹ
+ * @retval  ERROR   : ʼʧ
+ ******************************************************************************
+ */
+status_t
+telnet_init(uint16_t port, uint32_t stacksize)
+{
+    if (the_telnetd_id != NULL)
+    {
+        return OK; /* already called */
+    }
+
+    the_telnet_port = (port == 0u) ? TELNET_PORT : port;
+    stacksize = (stacksize == 0) ? TASK_STK_SIZE_TELNETD : stacksize;
+
+    the_telnetd_id = taskSpawn((const signed char * const )"telnetd",
+            TASK_PRIORITY_TELNET, stacksize, (OSFUNCPTR)telnet_loop, 0);
+    D_ASSERT(the_telnetd_id != NULL);
+
+    return (the_telnetd_id != NULL) ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   telnet״̬
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+telnet_show_info(void)
+{
+    uint32_t i;
+
+    printf("  TELNET INFOMATION\n");
+    printf("port:%u  accepted:%u  rejected:%u\n", the_telnet_port,
+            the_telnet_accepted, the_telnet_rejected);
+    for (i = 0u; i < TELNET_MAX_SESSIONS; i++)
+    {
+        if (the_telnet_sess[i].pconn != NULL)
+        {
+            printf("session %u: %s%s\n", i, taskName(the_telnet_sess[i].tid),
+                    (the_telnet_sess[i].tid == taskIdSelf()) ? " (self)" : "");
+        }
+    }
+    printf("\n");
+}
+
+/*SHELL CMD FOR TELNET*/
+uint32_t
+do_telnet(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    telnet_show_info();
+    return 0;
+}
+
+SHELL_CMD(telnet, 1, do_telnet, "telnet -- show telnet sessions\r\n");
+
+uint32_t
+do_logout(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    TASK_ID tid = taskIdSelf();
+    uint32_t i;
+
+    for (i = 0u; i < TELNET_MAX_SESSIONS; i++)
+    {
+        if ((the_telnet_sess[i].pconn != NULL)
+                && (the_telnet_sess[i].tid == tid))
+        {
+            the_telnet_sess[i].closing = TRUE;
+            return 0;
+        }
+    }
+    printf("not a telnet session\n");
+    return 1;
+}
+
+SHELL_CMD(logout, 1, do_logout, "logout -- close this telnet session\r\n");
+
+/*-------------------------------telnetLib.c---------------------------------*/
@@ -0,0 +1,192 @@
+/**
+ ******************************************************************************
+ * @file       tmrbench.c
+ * @brief      ʱܲ.
+ * @details    Զװʱ(Ĭ1000, 1~6), 
+ *             λֹͣɾÿʱƽʱ(ʱ,
+ *             ʱȼshell, ), Լ2
+ *             ڻص. λΪ΢(bsp_timer_get).
+ *             ֱconfigUSE_TIMER_WHEELΪ01ɶԱʱ.
+ *             ÿʱԼռ40ֽڶ, 1000Լ40KconfigTOTAL_HEAP_SIZE.
+ *             ͬʱINCLUDE_SOFT_TIMERS.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <types.h>
+#include <shell.h>
+#include <oshook.h>
+#include <taskLib.h>
+#include <oscfg.h>
+#include <FreeRTOS.h>
+#include <timers.h>
+
+#ifndef INCLUDE_TIMER_BENCH
+# define INCLUDE_TIMER_BENCH        (0u)    /**< 붨ʱܲ */
+#endif
+
+#if (INCLUDE_TIMER_BENCH == 1u) && (configUSE_TIMERS == 1)
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define TMRBENCH_DEFAULT_TIMERS  (1000u)    /**< Ĭ϶ʱ */
+#define TMRBENCH_MIN_PERIOD (TICKS_PER_SECOND)  /**< (tick) */
+#define TMRBENCH_SPREAD     (TICKS_PER_SECOND * 5u) /**< ڴΧ(tick) */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** һʱ */
+typedef portBASE_TYPE (*tmrbench_op_t)(xTimerHandle timer);
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static volatile uint32_t the_tmrbench_fires = 0u;
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief      ʱص, ֻ
+ ******************************************************************************
+ */
+static void
+tmrbench_callback(xTimerHandle timer)
+{
+    (void)timer;
+    the_tmrbench_fires++;
+}
+
+static portBASE_TYPE
+tmrbench_start(xTimerHandle timer)
+{
+    return xTimerStart(timer, portMAX_DELAY);
+}
+
+static portBASE_TYPE
+tmrbench_reset(xTimerHandle timer)
+{
+    return xTimerReset(timer, portMAX_DELAY);
+}
+
+static portBASE_TYPE
+tmrbench_stop(xTimerHandle timer)
+{
+    return xTimerStop(timer, portMAX_DELAY);
+}
+
+static portBASE_TYPE
+tmrbench_delete(xTimerHandle timer)
+{
+    return xTimerDelete(timer, portMAX_DELAY);
+}
+
+/**
+ ******************************************************************************
+ * @brief      жʱִһƽʱ
+ * @param[in]  pname  : 
+ * @param[in]  pop    : 
+ * @param[in]  ptimers: ʱ
+ * @param[in]  num    : ʱ
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+tmrbench_run(const char *pname, tmrbench_op_t pop, xTimerHandle *ptimers,
+        uint32_t num)
+{
+    uint32_t i;
+    uint32_t us;
+    uint32_t start = bsp_timer_get();
+
+    for (i = 0u; i < num; i++)
+    {
+        (void)pop(ptimers[i]);
+    }
+    us = bsp_timer_get() - start;
+
+    printf("%-8s %10u us %8u ns/op\n", pname, us,
+            (uint32_t)(((uint64_t)us * 1000u) / num));
+}
+
+/**
+ ******************************************************************************
+ * @brief      tmrbench: Դʱµʱ
+ * @param[in]  argv[1] : ʱ(ѡ)
+ *
+ * @retval     0
+ ******************************************************************************
+ */
+uint32_t
+do_tmrbench(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    uint32_t num = TMRBENCH_DEFAULT_TIMERS;
+    uint32_t i;
+    xTimerHandle *ptimers;
+
+    (void)cmdtp;
+    if (argc > 1u)
+    {
+        num = (uint32_t)strtoul((const char *)argv[1], NULL, 0);
+    }
+    if (num == 0u)
+    {
+        num = TMRBENCH_DEFAULT_TIMERS;
+    }
+
+    ptimers = malloc(num * sizeof(xTimerHandle));
+    if (ptimers == NULL)
+    {
+        printf("no memory\n");
+        return 1;
+    }
+    for (i = 0u; i < num; i++)
+    {
+        ptimers[i] = xTimerCreate((const signed char *)"bench",
+                TMRBENCH_MIN_PERIOD + ((i * 37u) % TMRBENCH_SPREAD), pdTRUE,
+                NULL, tmrbench_callback);
+        if (ptimers[i] == NULL)
+        {
+            break;
+        }
+    }
+    if (i < num)
+    {
+        printf("only %u timers created\n", i);
+        num = i;
+    }
+    if (num == 0u)
+    {
+        free(ptimers);
+        return 1;
+    }
+
+    printf("tmrbench: %u active timers, %s\n", num,
+            (configUSE_TIMER_WHEEL == 1) ? "wheel" : "list");
+    tmrbench_run("start", tmrbench_start, ptimers, num);
+    tmrbench_run("reset", tmrbench_reset, ptimers, num);
+
+    the_tmrbench_fires = 0u;
+    taskDelay(TMRBENCH_MIN_PERIOD * 2u);
+    printf("fires    %10u in 2s\n", the_tmrbench_fires);
+
+    tmrbench_run("stop", tmrbench_stop, ptimers, num);
+    tmrbench_run("delete", tmrbench_delete, ptimers, num);
+    free(ptimers);
+
+    return 0;
+}
+
+SHELL_CMD(tmrbench, 2, do_tmrbench, "tmrbench [timers]\r\n");
+
+#endif /* INCLUDE_TIMER_BENCH */
+/*-------------------------------tmrbench.c----------------------------------*/
@@ -0,0 +1,422 @@
+/**
+ ******************************************************************************
+ * @file      topLib.c
+ * @brief     ʵCPUռջʹü.
+ * @details   TaskMonÿTOP_SAMPLE_TICKSͨuxTaskGetSystemState()
+ *            ʱ(bsp_timer_get, us)Ͷջˮλ, һ
+ *            ڼTOP_WINDOWڵCPUռʡʡÿл
+ *            ͶջСʣ. top_snapshot()shelltopȡ.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <types.h>
+#include <maths.h>
+#include <taskLib.h>
+#include <dmnLib.h>
+#include <debug.h>
+#include <topLib.h>
+#include <shell.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <oscfg.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef TASK_PRIORITY_TOP
+# define TASK_PRIORITY_TOP           (1u)    /**< ȼ */
+#endif
+
+#ifndef TASK_STK_SIZE_TOP
+# define TASK_STK_SIZE_TOP         (512u)    /**< ջ */
+#endif
+
+#ifndef TOP_MAX_TASKS
+# define TOP_MAX_TASKS              (16u)    /**< ͳƵ */
+#endif
+
+#ifndef TOP_SAMPLE_TICKS
+# define TOP_SAMPLE_TICKS  (TICKS_PER_SECOND) /**< (tick) */
+#endif
+
+#ifndef TOP_WINDOW
+# define TOP_WINDOW                 (10u)    /**< ڰĲ */
+#endif
+
+#define TOP_PERCENT             (10000u)    /**< 100.00% */
+
+C_ASSERT(TOP_NAME_LEN < configMAX_TASK_NAME_LEN);
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ÿĲ¼ */
+typedef struct
+{
+    bool_e used;                    /**< λѱռ */
+    bool_e seen;                    /**< βд */
+    uint32_t number;                /**< (xTaskNumber) */
+    uint32_t last_run;              /**< ϴβʱʱ */
+    uint32_t hist[TOP_WINDOW];      /**< ڵʱ */
+    uint32_t sum;                   /**< hist֮ */
+    top_task_t info;                /**< ͳƽ */
+} top_slot_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static TASK_ID the_top_taskid = NULL;
+
+static xTaskStatusType the_top_status[TOP_MAX_TASKS];  /**<  */
+static top_slot_t the_top_slots[TOP_MAX_TASKS];
+static top_sys_t the_top_sys;
+
+static uint32_t the_top_total_hist[TOP_WINDOW];  /**< ڵʱ */
+static uint32_t the_top_total_sum = 0u;
+static uint32_t the_top_idle_hist[TOP_WINDOW];   /**< ڵĿʱ */
+static uint32_t the_top_idle_sum = 0u;
+static uint32_t the_top_pos = 0u;                /**< еĵǰλ */
+static uint32_t the_top_samples = 0u;            /**< ɵĲ */
+
+static uint32_t the_top_last_total = 0u;
+static uint32_t the_top_last_switches = 0u;
+static uint32_t the_top_last_tick = 0u;
+static uint32_t the_top_overflow = 0u;  /**< TOP_MAX_TASKSĴ */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ռ
+ * @param[in]  part  : ʱ
+ * @param[in]  total : ʱ
+ *
+ * @retval     ռ(0.01%)
+ ******************************************************************************
+ */
+static uint16_t
+top_ratio(uint32_t part, uint32_t total)
+{
+    if (total == 0u)
+    {
+        return 0u;
+    }
+    if (part >= total)
+    {
+        return TOP_PERCENT;
+    }
+    return (uint16_t)(((unsigned long long)part * TOP_PERCENT) / total);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ŲҲλ, Ҳʱвλ
+ * @param[in]  number : 
+ *
+ * @retval     NULL : λ
+ * @retval     NULL   : λ
+ ******************************************************************************
+ */
+static top_slot_t *
+top_slot_get(uint32_t number)
+{
+    top_slot_t *pfree = NULL;
+    uint32_t i;
+
+    for (i = 0u; i < TOP_MAX_TASKS; i++)
+    {
+        if (the_top_slots[i].used == FALSE)
+        {
+            if (pfree == NULL)
+            {
+                pfree = &the_top_slots[i];
+            }
+        }
+        else if (the_top_slots[i].number == number)
+        {
+            return &the_top_slots[i];
+        }
+    }
+    if (pfree != NULL)
+    {
+        memset(pfree, 0, sizeof(*pfree));
+        pfree->used = TRUE;
+        pfree->number = number;
+    }
+    return pfree;
+}
+
+/**
+ ******************************************************************************
+ * @brief   һβͳƽ
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+top_sample(void)
+{
+    xTaskStatusType *pst;
+    top_slot_t *pslot;
+    unsigned long total;
+    uint32_t n;
+    uint32_t i;
+    uint32_t delta;
+    uint32_t dtotal;
+    uint32_t didle = 0u;
+    uint32_t dtick;
+    uint32_t switches = (uint32_t)_the_task_switches;
+    uint32_t tick = tickGet();
+    uint32_t stack_free = 0xffffffffu;
+
+    /* 鲻ʱ0 */
+    n = uxTaskGetSystemState(the_top_status, TOP_MAX_TASKS, &total);
+    if (n == 0u)
+    {
+        the_top_overflow++;
+        return;
+    }
+    dtotal = (uint32_t)total - the_top_last_total;
+    dtick = tick - the_top_last_tick;
+
+    taskLock();
+    for (i = 0u; i < TOP_MAX_TASKS; i++)
+    {
+        the_top_slots[i].seen = FALSE;
+    }
+
+    for (i = 0u; i < n; i++)
+    {
+        pst = &the_top_status[i];
+        pslot = top_slot_get(pst->xTaskNumber);
+        if (pslot == NULL)
+        {
+            continue;
+        }
+        pslot->seen = TRUE;
+
+        /* һβǰʱ䲻; ֮½0ʼ */
+        delta = (the_top_samples == 0u) ? 0u
+                : ((uint32_t)pst->ulRunTimeCounter - pslot->last_run);
+        pslot->last_run = (uint32_t)pst->ulRunTimeCounter;
+        pslot->sum = pslot->sum - pslot->hist[the_top_pos] + delta;
+        pslot->hist[the_top_pos] = delta;
+
+        pslot->info.tid = (TASK_ID)pst->xHandle;
+        strncpy(pslot->info.name, (const char_t *)pst->pcTaskName,
+                TOP_NAME_LEN - 1u);
+        pslot->info.name[TOP_NAME_LEN - 1u] = '\0';
+        pslot->info.prio = (uint8_t)pst->uxCurrentPriority;
+        pslot->info.state = (uint8_t)pst->eCurrentState;
+        pslot->info.stack_free = (uint32_t)pst->usStackHighWaterMark
+                * sizeof(portSTACK_TYPE);
+        if (pslot->info.stack_free < stack_free)
+        {
+            stack_free = pslot->info.stack_free;
+        }
+
+        if (strcmp(pslot->info.name, "IDLE") == 0)
+        {
+            didle = delta;
+        }
+    }
+
+    the_top_total_sum = the_top_total_sum - the_top_total_hist[the_top_pos]
+            + ((the_top_samples == 0u) ? 0u : dtotal);
+    the_top_total_hist[the_top_pos] = (the_top_samples == 0u) ? 0u : dtotal;
+    the_top_idle_sum = the_top_idle_sum - the_top_idle_hist[the_top_pos]
+            + didle;
+    the_top_idle_hist[the_top_pos] = didle;
+
+    for (i = 0u; i < TOP_MAX_TASKS; i++)
+    {
+        pslot = &the_top_slots[i];
+        if (pslot->used == FALSE)
+        {
+            continue;
+        }
+        if (pslot->seen == FALSE)
+        {
+            pslot->used = FALSE;    /* ɾ */
+            continue;
+        }
+        pslot->info.cpu_now = top_ratio(pslot->hist[the_top_pos],
+                the_top_total_hist[the_top_pos]);
+        pslot->info.cpu_avg = top_ratio(pslot->sum, the_top_total_sum);
+    }
+
+    the_top_sys.idle_now = top_ratio(didle, the_top_total_hist[the_top_pos]);
+    the_top_sys.idle_avg = top_ratio(the_top_idle_sum, the_top_total_sum);
+    the_top_sys.switches = (dtick == 0u) ? 0u
+            : (((switches - the_top_last_switches) * TICKS_PER_SECOND) / dtick);
+    the_top_sys.stack_free = stack_free;
+    the_top_sys.ntasks = n;
+    the_top_samples++;
+    the_top_sys.window = MIN(the_top_samples - 1u, TOP_WINDOW);
+    taskUnlock();
+
+    the_top_pos = (the_top_pos + 1u) % TOP_WINDOW;
+    the_top_last_total = (uint32_t)total;
+    the_top_last_switches = switches;
+    the_top_last_tick = tick;
+}
+
+/**
+ ******************************************************************************
+ * @brief   TaskMonִ
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+top_loop(void)
+{
+    uint32_t wake = tickGet();
+    DMN_ID dmnid = dmn_register();
+    D_ASSERT(dmnid != NULL);
+
+    while (1)
+    {
+        dmn_sign(dmnid);
+        top_sample();
+        wake += TOP_SAMPLE_TICKS;
+        if ((int32_t)(wake - tickGet()) > 0)
+        {
+            taskDelay(wake - tickGet());
+        }
+        else
+        {
+            wake = tickGet();   /* ̫, ¶ */
+        }
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ӳʼ
+ * @param[in]  stacksize : ջС, 0ʹĬֵ
+ *
+ * @retval  OK      : ʼɹ
+ * @retval  ERROR   : ʼʧ
+ ******************************************************************************
+ */
+status_t
+top_init(uint32_t stacksize)
+{
+    if (the_top_taskid != NULL)
+    {
+        return OK; /* already called */
+    }
+
+    stacksize = (stacksize == 0) ? TASK_STK_SIZE_TOP : stacksize;
+    the_top_taskid = taskSpawn((const signed char * const )"TaskMon",
+            TASK_PRIORITY_TOP, stacksize, (OSFUNCPTR)top_loop, 0);
+    D_ASSERT(the_top_taskid != NULL);
+
+    return (the_top_taskid != NULL) ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡһβͳƽ
+ * @param[out] psys   : ϵͳͳ, ΪNULL
+ * @param[out] ptasks : ͳ, ΪNULL
+ * @param[in]  max    : ptasksС
+ *
+ * @retval     дptasks
+ ******************************************************************************
+ */
+uint32_t
+top_snapshot(top_sys_t *psys, top_task_t *ptasks, uint32_t max)
+{
+    uint32_t i;
+    uint32_t n = 0u;
+
+    taskLock();
+    if (psys != NULL)
+    {
+        *psys = the_top_sys;
+    }
+    for (i = 0u; (i < TOP_MAX_TASKS) && (ptasks != NULL) && (n < max); i++)
+    {
+        if (the_top_slots[i].used == TRUE)
+        {
+            ptasks[n++] = the_top_slots[i].info;
+        }
+    }
+    taskUnlock();
+
+    return n;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ϣ
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+top_show_info(void)
+{
+    static top_task_t the_top_copy[TOP_MAX_TASKS];
+    static const char_t the_state_chars[] = "XRBSD";
+    top_sys_t sys;
+    uint32_t n;
+    uint32_t i;
+
+    if (the_top_taskid == NULL)
+    {
+        printf("Task: TaskMon is not running!\n");
+        return;
+    }
+
+    /* shellв, ̬ռshellջ */
+    n = top_snapshot(&sys, the_top_copy, TOP_MAX_TASKS);
+    printf("tasks:%u  idle:%u.%02u%% (%us avg %u.%02u%%)  switches:%u/s"
+            "  min stack free:%uB\n", sys.ntasks,
+            sys.idle_now / 100u, sys.idle_now % 100u,
+            (sys.window * TOP_SAMPLE_TICKS) / TICKS_PER_SECOND,
+            sys.idle_avg / 100u, sys.idle_avg % 100u,
+            sys.switches, sys.stack_free);
+    if (the_top_overflow != 0u)
+    {
+        printf("warning: more than %u tasks, %u samples skipped\n",
+                TOP_MAX_TASKS, the_top_overflow);
+    }
+    printf("  Name      Pri  S    CPU%%    Avg%%  StackFree\n");
+    for (i = 0u; i < n; i++)
+    {
+        printf("  %-8s  %3u  %c  %3u.%02u  %3u.%02u  %9u\n",
+                the_top_copy[i].name, the_top_copy[i].prio,
+                (the_top_copy[i].state < (sizeof(the_state_chars) - 1u))
+                ? the_state_chars[the_top_copy[i].state] : '?',
+                the_top_copy[i].cpu_now / 100u, the_top_copy[i].cpu_now % 100u,
+                the_top_copy[i].cpu_avg / 100u, the_top_copy[i].cpu_avg % 100u,
+                the_top_copy[i].stack_free);
+    }
+    printf("\n");
+}
+
+/*SHELL CMD FOR TOP*/
+uint32_t
+do_top(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    top_show_info();
+    return 0;
+}
+
+SHELL_CMD(top, 1, do_top, "top -- show task cpu usage and stack free\r\n");
+
+/*---------------------------------topLib.c----------------------------------*/
@@ -36,7 +36,7 @@ Section: Global Variables
 /*-----------------------------------------------------------------------------
 Section: Local Variables
 -----------------------------------------------------------------------------*/
-/* NONE */
+static tty_exparam_t * volatile the_console_tty = NULL; /**< ̨tty */
 
 /*-----------------------------------------------------------------------------
 Section: Local Function Prototypes
@@ -72,6 +72,11 @@ static status_t
 ttylib_release(struct device* dev)
 {
     free(TTY_EXPARAM.ring.rd.buf);
+    if (TTY_EXPARAM.rxsem != NULL)
+    {
+        semDelete(TTY_EXPARAM.rxsem);
+        TTY_EXPARAM.rxsem = NULL;
+    }
     return OK;
 }
 
@@ -188,6 +193,16 @@ ttylib_ioctl(struct device* dev, uint32_t cmd, void *args)
         case TTY_FIONREAD:  /* ȡǰջַ */
             return ring_check(&TTY_EXPARAM.ring.rd);
             break;
+        case TTY_FIOCONSOLE:/* Ϊ̨, Ϳʱжϻ */
+            the_console_tty = &TTY_EXPARAM;
+            break;
+        case TTY_FIORXSEM:  /* ȡź, 豸֮ȴ */
+            if (args == NULL)
+            {
+                return -1;
+            }
+            *(SEM_ID *)args = TTY_EXPARAM.rxsem;
+            break;
         case TTY_BAUD_SET:  /* ͨѶ */
             if (TTY_EXPARAM.popt->set_param != NULL)
             {
@@ -211,7 +226,15 @@ ttylib_ioctl(struct device* dev, uint32_t cmd, void *args)
 uint16_t
 ttylib_getchar(tty_exparam_t *pexparam, uint8_t *pch)
 {
-    return ring_read(&pexparam->ring.wt, pch, 1u);
+    if (ring_read(&pexparam->ring.wt, pch, 1u) != 0u)
+    {
+        return 1u;
+    }
+    if (pexparam == the_console_tty)
+    {
+        return console_isr_getchar(pch);    /* жеprintf */
+    }
+    return 0u;
 }
 
 /**
@@ -221,12 +244,39 @@ ttylib_getchar(tty_exparam_t *pexparam, uint8_t *pch)
  * @param[out] pch      : д
  *
  * @retval     None
+ *
+ * @details ջɿձǿʱͷrxsemѶ, ʱظͷ.
+ *          ջٵȴrxsem.
  ******************************************************************************
  */
 void
 ttylib_putchar(tty_exparam_t *pexparam, uint8_t ch)
 {
+    bool_e wake = ring_if_empty(&pexparam->ring.rd);
+
     (void)ring_write_force(&pexparam->ring.rd, &ch, 1u);
+    if ((wake == TRUE) && (pexparam->rxsem != NULL))
+    {
+        (void)semGive(pexparam->rxsem);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ̨tty, жprintfȡж
+ * @param[in]  None
+ * @retval     None
+ ******************************************************************************
+ */
+void
+ttylib_console_kick(void)
+{
+    tty_exparam_t *pexparam = the_console_tty;
+
+    if ((pexparam != NULL) && (pexparam->popt->tx_enable != NULL))
+    {
+        pexparam->popt->tx_enable(pexparam, TRUE);
+    }
 }
 
 /** tty豸 */
@@ -264,6 +314,12 @@ tty_create(uint8_t ttyno, tty_exparam_t *pexparam, uint16_t rdsz, uint16_t wtsz)
     }
     ring_init(&pexparam->ring.rd, pbuf, rdsz);
     ring_init(&pexparam->ring.wt, pbuf + rdsz, wtsz);
+    pexparam->rxsem = semBCreate(0);
+    if (pexparam->rxsem == NULL)
+    {
+        free(pbuf);
+        return ERROR;
+    }
 
     char_t name[5];
     (void)sprintf(name, "tty%d", ttyno);
@@ -301,6 +357,7 @@ tty_show_info(void)
                 ((tty_exparam_t*)pdev->param)->ring.wt.len
                 );
     }
+    printf("console isr output lost:%u\n", console_isr_lost());
     printf("\n");
 }
 
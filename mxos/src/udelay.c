@@ -46,6 +46,9 @@
 extern uint32_t
 bsp_timer_get(void);
 
+extern uint32_t
+_default_bsp_timer_get(void);   /* oshook.cеĬʵ */
+
 /*-----------------------------------------------------------------------------
  Section: Function Definitions
  ----------------------------------------------------------------------------*/
@@ -58,19 +61,23 @@ bsp_timer_get(void);
  * @retval     None
  *
  * @details
- *  ʵΪæȣ賤ʱʱʹtaskDelay
+ *  ʵΪæȣ賤ʱʱʹtaskDelaytaskDelayUs
  ******************************************************************************
  */
 void
 _usleep(uint32_t us)
 {
-    uint32_t time_out = us + bsp_timer_get();
+    uint32_t start;
 
-    if (time_out == us)
+    /* bspδʵֶʱʱbsp_timer_getָĬʵ; ԶΪ0ж,
+       ʱҲ0 */
+    if (bsp_timer_get == _default_bsp_timer_get)
     {
         return;
     }
-    while (bsp_timer_get() < time_out)
+    /* ֵȽ, ʱȻȷ */
+    start = bsp_timer_get();
+    while ((uint32_t)(bsp_timer_get() - start) < us)
     {
         ;   /* æ */
     }
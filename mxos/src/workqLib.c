@@ -0,0 +1,412 @@
+/**
+ ******************************************************************************
+ * @file      workqLib.c
+ * @brief     ʵж°벿.
+ * @details   жֻwork_submitѹҵ, ʱworker
+ *            , жʱ; һworker, ʡȥջ.
+ *            ɵ߾̬, , ύʱڴ, 
+ *            же. ڶʱظύִֻһ(ϲ), ʼ
+ *            ִǰpending, ִڼٴύִһ.
+ *            һпжworker, ʱͬһworkerϲ
+ *            ִ, ҪеĹŵworker.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <types.h>
+#include <taskLib.h>
+#include <intLib.h>
+#include <oshook.h>
+#include <shell.h>
+#include <workqLib.h>
+#include <oscfg.h>
+#include <FreeRTOS.h>
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#ifndef TASK_PRIORITY_WORKQ
+# define TASK_PRIORITY_WORKQ        (0u)    /**< ϵͳȼ */
+#endif
+
+#ifndef TASK_STK_SIZE_WORKQ
+# define TASK_STK_SIZE_WORKQ      (512u)    /**< ϵͳջ */
+#endif
+
+#ifndef WORKQ_WORKERS
+# define WORKQ_WORKERS              (1u)    /**< ϵͳworker */
+#endif
+
+#ifndef WORKQ_MAX
+# define WORKQ_MAX                  (4u)    /**< ഴĹ */
+#endif
+
+#define WORKQ_NAME_SIZE             (8u)    /**<  */
+
+/* ύж, ֻοɵϵͳӿڵж */
+#define WQ_LOCK(key)        ((key) = intLock())
+#define WQ_UNLOCK(key)      intUnlock(key)
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/**  */
+struct workq
+{
+    work_t *phead;              /**< ִй */
+    work_t *ptail;
+    SEM_ID sem;                 /**< : ִеĹ */
+    char_t name[WORKQ_NAME_SIZE];
+    uint32_t priority;
+    uint32_t workers;
+
+    /* ͳ */
+    uint32_t depth;             /**< ǰг */
+    uint32_t max_depth;         /**< г */
+    uint32_t submitted;         /**< Ӵ */
+    uint32_t coalesced;         /**< ϲظύ */
+    uint32_t executed;          /**< ִд */
+    uint32_t max_latency;       /**< ύʼִеӳ(us) */
+};
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static struct workq *the_workqs[WORKQ_MAX];    /**< ѴĶ(taskLock) */
+static uint32_t the_workq_num = 0u;
+static WORKQ_ID the_sys_workq = NULL;   /**< ϵͳ, wqΪNULLʱʹ */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   worker
+ * @param[in]  pwq : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+static void
+workq_loop(struct workq *pwq)
+{
+    work_t *pwork;
+    uint32_t latency;
+    uint32_t key;
+
+    while (TRUE)
+    {
+        (void)semTake(pwq->sem, WAIT_FOREVER);
+
+        WQ_LOCK(key);
+        pwork = pwq->phead;
+        if (pwork != NULL)
+        {
+            pwq->phead = pwork->pnext;
+            if (pwq->phead == NULL)
+            {
+                pwq->ptail = NULL;
+            }
+            pwq->depth--;
+            pwork->pnext = NULL;
+            pwork->pending = FALSE;
+        }
+        WQ_UNLOCK(key);
+
+        if (pwork == NULL)
+        {
+            continue;   /* ѱwork_cancelȡ */
+        }
+
+        latency = bsp_timer_get() - pwork->stamp;
+        if (latency > pwq->max_latency)
+        {
+            pwq->max_latency = latency;
+        }
+        pwork->func(pwork->arg);
+        pwq->executed++;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   
+ * @param[in]  pname     : , workerΪƼ
+ * @param[in]  priority  : workerȼ
+ * @param[in]  workers   : worker, 01
+ * @param[in]  stacksize : workerջС, 0ʹĬֵ
+ *
+ * @retval  , NULL: ʧ
+ *
+ * @details taskLock, ͬһǼǲλ;
+ *          workertaskUnlockſʼ.
+ ******************************************************************************
+ */
+WORKQ_ID
+workq_create(const char_t *pname, uint32_t priority, uint32_t workers,
+        uint32_t stacksize)
+{
+    struct workq *pwq;
+    char_t tname[WORKQ_NAME_SIZE + 4u];
+    uint32_t i;
+
+    if (pname == NULL)
+    {
+        return NULL;
+    }
+
+    taskLock();
+    if (the_workq_num >= WORKQ_MAX)
+    {
+        taskUnlock();
+        return NULL;
+    }
+    pwq = malloc(sizeof(struct workq));
+    if (pwq == NULL)
+    {
+        taskUnlock();
+        return NULL;
+    }
+    memset(pwq, 0, sizeof(struct workq));
+    pwq->sem = semCCreate(0u, 0xFFFFFFFFu);
+    if (pwq->sem == NULL)
+    {
+        free(pwq);
+        taskUnlock();
+        return NULL;
+    }
+    (void)snprintf(pwq->name, sizeof(pwq->name), "%s", pname);
+    pwq->priority = priority;
+    pwq->workers = (workers == 0u) ? 1u : workers;
+    stacksize = (stacksize == 0u) ? TASK_STK_SIZE_WORKQ : stacksize;
+
+    for (i = 0u; i < pwq->workers; i++)
+    {
+        (void)snprintf(tname, sizeof(tname), "%s%u", pwq->name, i);
+        if (taskSpawn((const signed char * const )tname, priority, stacksize,
+                (OSFUNCPTR)workq_loop, (uint32_t)pwq) == NULL)
+        {
+            /* Ѵworker */
+            pwq->workers = i;
+            break;
+        }
+    }
+    if (pwq->workers == 0u)
+    {
+        semDelete(pwq->sem);
+        free(pwq);
+        taskUnlock();
+        return NULL;
+    }
+    the_workqs[the_workq_num++] = pwq;
+    taskUnlock();
+
+    return pwq;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ϵͳ
+ * @param[in]  stacksize : workerջС, 0ʹĬֵ
+ *
+ * @retval  OK      : ʼɹ
+ * @retval  ERROR   : ʼʧ
+ ******************************************************************************
+ */
+status_t
+workq_init(uint32_t stacksize)
+{
+    if (the_sys_workq != NULL)
+    {
+        return OK; /* already called */
+    }
+    the_sys_workq = workq_create("wq", TASK_PRIORITY_WORKQ, WORKQ_WORKERS,
+            stacksize);
+
+    return (the_sys_workq != NULL) ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʼ
+ * @param[in]  pwork : 
+ * @param[in]  func  : 
+ * @param[in]  arg   : 
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+work_init(work_t *pwork, WORK_FUNC func, void *arg)
+{
+    pwork->pnext = NULL;
+    pwork->func = func;
+    pwork->arg = arg;
+    pwork->stamp = 0u;
+    pwork->pending = FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ύ
+ * @param[in]  wq    : , NULLʹϵͳ
+ * @param[in]  pwork : 
+ *
+ * @retval  OK    : , ڶ(ϲ)
+ * @retval  ERROR : в
+ *
+ * @details же, ڴ, ִʱ̶.
+ ******************************************************************************
+ */
+status_t
+work_submit(WORKQ_ID wq, work_t *pwork)
+{
+    struct workq *pwq = (wq != NULL) ? wq : the_sys_workq;
+    uint32_t key;
+
+    if ((pwq == NULL) || (pwork == NULL) || (pwork->func == NULL))
+    {
+        return ERROR;
+    }
+
+    WQ_LOCK(key);
+    if (pwork->pending == TRUE)
+    {
+        pwq->coalesced++;
+        WQ_UNLOCK(key);
+        return OK;
+    }
+    pwork->pending = TRUE;
+    pwork->stamp = bsp_timer_get();
+    pwork->pnext = NULL;
+    if (pwq->ptail == NULL)
+    {
+        pwq->phead = pwork;
+    }
+    else
+    {
+        pwq->ptail->pnext = pwork;
+    }
+    pwq->ptail = pwork;
+    pwq->submitted++;
+    if (++pwq->depth > pwq->max_depth)
+    {
+        pwq->max_depth = pwq->depth;
+    }
+    WQ_UNLOCK(key);
+
+    return semGive(pwq->sem);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡδִеĹ
+ * @param[in]  wq    : , NULLʹϵͳ
+ * @param[in]  pwork : 
+ *
+ * @retval  OK    : ѴӶƳ
+ * @retval  ERROR : ڶ(δύִлִ)
+ *
+ * @details же. ȴִеĹ.
+ ******************************************************************************
+ */
+status_t
+work_cancel(WORKQ_ID wq, work_t *pwork)
+{
+    struct workq *pwq = (wq != NULL) ? wq : the_sys_workq;
+    work_t **pp;
+    work_t *pprev = NULL;
+    status_t ret = ERROR;
+    uint32_t key;
+
+    if ((pwq == NULL) || (pwork == NULL))
+    {
+        return ERROR;
+    }
+
+    WQ_LOCK(key);
+    if (pwork->pending == TRUE)
+    {
+        for (pp = &pwq->phead; *pp != NULL; pp = &(*pp)->pnext)
+        {
+            if (*pp == pwork)
+            {
+                *pp = pwork->pnext;
+                if (pwq->ptail == pwork)
+                {
+                    pwq->ptail = pprev;
+                }
+                pwq->depth--;
+                pwork->pnext = NULL;
+                pwork->pending = FALSE;
+                ret = OK;
+                break;
+            }
+            pprev = *pp;
+        }
+    }
+    WQ_UNLOCK(key);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ƿڶеȴִ
+ * @param[in]  pwork : 
+ *
+ * @retval  TRUE  : ȴִ
+ * @retval  FALSE : δύִлִ
+ ******************************************************************************
+ */
+bool_e
+work_pending(const work_t *pwork)
+{
+    return pwork->pending;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ״̬
+ * @param[in]  None
+ *
+ * @retval     None
+ ******************************************************************************
+ */
+void
+workq_show_info(void)
+{
+    uint32_t i;
+    struct workq *pwq;
+
+    printf("  WORKQ INFOMATION\n");
+    printf("NAME     PRI WKR DEPTH  MAX  SUBMIT  COALESCE    EXEC  MAXLAT(us)\n");
+    for (i = 0u; i < the_workq_num; i++)
+    {
+        pwq = the_workqs[i];
+        printf("%-8s %3u %3u %5u %4u %7u %9u %7u %11u\n", pwq->name,
+                pwq->priority, pwq->workers, pwq->depth, pwq->max_depth,
+                pwq->submitted, pwq->coalesced, pwq->executed,
+                pwq->max_latency);
+    }
+    printf("\n");
+}
+
+/*SHELL CMD FOR WORKQ*/
+uint32_t
+do_workq(cmd_tbl_t *cmdtp, uint32_t argc, const uint8_t *argv[])
+{
+    workq_show_info();
+    return 0;
+}
+
+SHELL_CMD(workq, 1, do_workq, "workq -- show work queue state\r\n");
+
+/*--------------------------------workqLib.c---------------------------------*/